@@ -0,0 +1,499 @@
+#include <cadmium/modeling/celldevs/grid/coupled.hpp>
+#include <cadmium/simulation/root_coordinator.hpp>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "include/vegetationCell.hpp"
+#include "include/vegetationDense.hpp"
+#include "include/vegetationProfile.hpp"
+#include "include/vegetationRun.hpp"
+
+using namespace cadmium::celldevs;
+using namespace cadmium;
+
+// -----------------------
+// Allocation counting
+// -----------------------
+// Every operator new in this executable goes through here, so a run's allocation
+// count is the difference of two readings. The replacements are kept out of line:
+// once inlined, GCC pairs the malloc in operator new with the free in operator delete
+// and reports every new/delete as mismatched (-Wmismatched-new-delete).
+static std::atomic<uint64_t> allocationCount{0};
+
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+BENCH_NOINLINE void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+BENCH_NOINLINE void* operator new[](std::size_t size) { return operator new(size); }
+BENCH_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete[](void* p) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// Options of one benchmark session
+struct benchOptions {
+    std::string mode = "regression";                 // --mode=regression|scaling|temporal|startup
+    std::vector<std::string> configs = {"config/vegetation_init_101_0.1_Config.json",
+                                        "config/vegetation_init_101_0.025_config.json"};
+    std::vector<std::pair<int, int>> sizes;          // --sizes=N,RxC,...: synthetic grids (empty: the mode's default)
+    std::vector<long> steps;                         // --steps=N,N,... (empty: the mode's default)
+    unsigned threads = 1;
+    std::string kernel = "auto";
+    bool cadmium = true;                             // --no-cadmium skips the Cadmium runs
+    std::string outPath = "bench_results.json";
+    std::string baselinePath;
+    double tolerance = 0.10;                         // allowed throughput drop before flagging
+};
+
+// One measured configuration; phases are ns per cell-update
+struct benchResult {
+    std::string name;           //!< baseline key: engine, scenario, steps and, for dense runs, threads and kernel
+    std::string engine;
+    unsigned threads = 1;
+    std::string kernel;         //!< dense row kernel actually used ("" for Cadmium)
+    int rows = 0;
+    int cols = 0;
+    long steps = 0;
+    double seconds = 0.0;
+    double cellUpdatesPerSecond = 0.0;
+    double allocationsPerStep = 0.0;
+    double peakRSS = 0.0;
+    bool finite = true;         //!< dense runs: every cell still finite at the end
+    std::map<std::string, double> phases;
+};
+
+// Phase counters of the profiled pass, normalised per cell-update
+static std::map<std::string, double> collectPhases(double cellUpdates) {
+    std::map<std::string, double> phases;
+    for (int p = 0; p < static_cast<int>(profilePhase::count); ++p) {
+        if (profileCounters[p].calls.load() == 0) continue;
+        phases[profilePhaseName(static_cast<profilePhase>(p))] =
+            static_cast<double>(profileCounters[p].ns.load()) / cellUpdates;
+    }
+    return phases;
+}
+
+static std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream in(text);
+    for (std::string item; std::getline(in, item, ',');) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+// Dense engine: an unprofiled pass for throughput and allocations, then a profiled pass for phases
+static benchResult benchDense(const std::string& name, const denseScenario& scenario, long steps,
+                              const benchOptions& opts) {
+    benchResult r;
+    r.engine = "dense";
+    r.threads = opts.threads;
+    r.kernel = selectRowKernel(opts.kernel).name;
+    r.name = "dense/" + name + "/steps=" + std::to_string(steps) + "/threads=" + std::to_string(r.threads) +
+             "/kernel=" + r.kernel;
+    r.rows = scenario.rows;
+    r.cols = scenario.cols;
+    r.steps = steps;
+    const double cellUpdates = static_cast<double>(scenario.rows) * scenario.cols * static_cast<double>(steps);
+    {
+        vegetationDense engine(scenario, opts.kernel);
+        engine.setThreads(opts.threads);
+        engine.advance(1);  // first touch of the planes and thread-local scratch
+        const uint64_t allocations = allocationCount.load();
+        const auto t0 = std::chrono::steady_clock::now();
+        engine.advance(steps);
+        r.seconds = secondsSince(t0);
+        r.allocationsPerStep = static_cast<double>(allocationCount.load() - allocations) / static_cast<double>(steps);
+        r.finite = engine.allFinite();
+    }
+    profileReset();
+    profilingEnabled = true;
+    {
+        vegetationDense engine(scenario, opts.kernel);
+        engine.setThreads(opts.threads);
+        engine.advance(steps);
+    }
+    profilingEnabled = false;
+    r.phases = collectPhases(cellUpdates);
+    r.cellUpdatesPerSecond = r.seconds > 0.0 ? cellUpdates / r.seconds : 0.0;
+    r.peakRSS = peakRSSMiB();
+    return r;
+}
+
+// One Cadmium run without a logger; returns simulate() time and fills the allocation count
+static double runCadmium(const std::string& path, long steps, uint64_t& allocations) {
+    std::shared_ptr<GridCellDEVSCoupled<vegetationState, double>> model;
+    {
+        profileScope profile(profilePhase::modelBuild);
+        model = std::make_shared<GridCellDEVSCoupled<vegetationState, double>>("vegetation", addGridCell, path);
+        model->buildModel();
+    }
+    RootCoordinator rootCoordinator(model);
+    rootCoordinator.start();
+    const uint64_t before = allocationCount.load();
+    const auto t0 = std::chrono::steady_clock::now();
+    for (long t = 1; t <= steps; ++t) {
+        rootCoordinator.simulate(static_cast<double>(t));
+    }
+    const double seconds = secondsSince(t0);
+    allocations = allocationCount.load() - before;
+    rootCoordinator.stop();
+    return seconds;
+}
+
+static benchResult benchCadmium(const std::string& name, const std::string& path, int rows, int cols,
+                                long steps) {
+    benchResult r;
+    r.name = "cadmium/" + name + "/steps=" + std::to_string(steps);
+    r.engine = "cadmium";
+    r.rows = rows;
+    r.cols = cols;
+    r.steps = steps;
+    const double cellUpdates = static_cast<double>(rows) * cols * static_cast<double>(steps);
+    uint64_t allocations = 0;
+    r.seconds = runCadmium(path, steps, allocations);
+    r.allocationsPerStep = static_cast<double>(allocations) / static_cast<double>(steps);
+
+    profileReset();
+    profilingEnabled = true;
+    const double profiled = runCadmium(path, steps, allocations);
+    profilingEnabled = false;
+    const auto simulated = static_cast<uint64_t>(profiled * 1e9);
+    const uint64_t cells = profileNanoseconds(profilePhase::localComputation);
+    profileAdd(profilePhase::routing, simulated > cells ? simulated - cells : 0);
+    r.phases = collectPhases(cellUpdates);
+    r.cellUpdatesPerSecond = r.seconds > 0.0 ? cellUpdates / r.seconds : 0.0;
+    r.peakRSS = peakRSSMiB();
+    return r;
+}
+
+// Column width of run names in the tables
+constexpr int runNameWidth = 80;
+
+// "baseline (N thread(s), K kernel)" from the top-level fields of a results file
+static std::string baselineLabel(const nlohmann::json& baseline) {
+    if (!baseline.contains("threads") || !baseline.contains("kernel")) return "the baseline (no thread count or kernel recorded)";
+    return "the baseline (" + std::to_string(baseline.at("threads").get<unsigned>()) + " thread(s), " +
+           baseline.at("kernel").get<std::string>() + " kernel)";
+}
+
+static nlohmann::json toJson(const benchResult& r) {
+    return {{"name", r.name}, {"engine", r.engine}, {"threads", r.threads}, {"kernel", r.kernel}, {"rows", r.rows}, {"cols", r.cols}, {"steps", r.steps},
+            {"seconds", r.seconds}, {"cell_updates_per_sec", r.cellUpdatesPerSecond},
+            {"allocations_per_step", r.allocationsPerStep}, {"peak_rss_mib", r.peakRSS}, {"finite", r.finite},
+            {"ns_per_cell_update", r.phases}};
+}
+
+/**
+ * @brief Compare results with a stored baseline by run name.
+ * Dense run names include the thread count and kernel, so a run is only compared
+ * with a baseline run of the same configuration. A run regresses if its throughput
+ * drops by more than the tolerance or it allocates more per step than before.
+ * @return number of regressions.
+ */
+static int compareBaseline(const nlohmann::json& results, const nlohmann::json& baseline, double tolerance) {
+    std::map<std::string, nlohmann::json> previous;
+    for (const auto& entry : baseline.at("results")) {
+        previous[entry.at("name").get<std::string>()] = entry;
+    }
+    const unsigned threads = results.at("threads").get<unsigned>();
+    const std::string kernel = results.at("kernel").get<std::string>();
+    if (baseline.value("threads", 0u) != threads || baseline.value("kernel", std::string{}) != kernel) {
+        std::cout << "\nNote: " << baselineLabel(baseline) << " differs from this session (" << threads
+                  << " thread(s), " << kernel << " kernel); its dense runs are not compared\n";
+    }
+    int regressions = 0;
+    std::cout << "\nBaseline comparison (tolerance " << std::fixed << std::setprecision(0) << 100.0 * tolerance
+              << "%)\n  " << std::left << std::setw(runNameWidth) << "run" << std::right
+              << "   baseline c-u/s    current c-u/s   change   allocs/step\n";
+    for (const auto& entry : results.at("results")) {
+        const std::string name = entry.at("name").get<std::string>();
+        const auto it = previous.find(name);
+        std::cout << "  " << std::left << std::setw(runNameWidth) << name << std::right;
+        if (it == previous.end()) {
+            std::cout << "  (not in baseline)\n";
+            continue;
+        }
+        const double before = it->second.at("cell_updates_per_sec").get<double>();
+        const double now = entry.at("cell_updates_per_sec").get<double>();
+        const double change = before > 0.0 ? now / before - 1.0 : 0.0;
+        const double allocBefore = it->second.at("allocations_per_step").get<double>();
+        const double allocNow = entry.at("allocations_per_step").get<double>();
+        const bool slower = change < -tolerance;
+        const bool moreAllocations = allocNow > allocBefore + 0.5;
+        std::cout << std::scientific << std::setprecision(3) << std::setw(17) << before << std::setw(17) << now
+                  << std::fixed << std::setprecision(1) << std::setw(8) << 100.0 * change << "%"
+                  << std::setw(8) << allocBefore << " -> " << allocNow
+                  << (slower || moreAllocations ? "  REGRESSION" : "") << "\n";
+        if (slower || moreAllocations) ++regressions;
+    }
+    std::cout << std::defaultfloat;
+    return regressions;
+}
+
+// Exit status of a session with `nonFinite` diverged runs: their timings measure NaN arithmetic, not the model
+static int reportNonFinite(int nonFinite) {
+    if (nonFinite == 0) return 0;
+    std::cerr << nonFinite << " run(s) went non-finite; their timings are not meaningful" << std::endl;
+    return 1;
+}
+
+// Scenarios for the scaling and temporal modes: the configs plus the synthetic grids
+static std::vector<std::pair<std::string, denseScenario>> benchScenarios(const benchOptions& opts) {
+    std::vector<std::pair<std::string, denseScenario>> scenarios;
+    for (const auto& path : opts.configs) {
+        scenarios.emplace_back(path, loadDenseScenario(path));
+    }
+    for (const auto& [rows, cols] : opts.sizes) {
+        scenarios.emplace_back("synthetic " + std::to_string(rows) + "x" + std::to_string(cols),
+                               syntheticDenseScenario(rows, cols));
+    }
+    return scenarios;
+}
+
+// --mode=scaling: dense stepping at 1..32 threads on each scenario, no logging
+static int runScalingBenchmark(const benchOptions& opts) {
+    const long steps = opts.steps.front();
+    int nonFinite = 0;
+    std::cout << "Scaling benchmark: " << steps << " steps per run, "
+              << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    for (const auto& [name, scenario] : benchScenarios(opts)) {
+        std::cout << name << " (" << scenario.rows << "x" << scenario.cols << ")" << std::endl;
+        std::cout << "  threads   tiles        seconds   cell-updates/s   speedup" << std::endl;
+        double baseline = 0.0;
+        for (unsigned threads : {1u, 2u, 4u, 8u, 16u, 32u}) {
+            vegetationDense engine(scenario, opts.kernel);
+            engine.setThreads(threads);
+            auto t0 = std::chrono::steady_clock::now();
+            for (long step = 0; step < steps; ++step) engine.step();
+            const double seconds = secondsSince(t0);
+            if (threads == 1) baseline = seconds;
+            if (!engine.allFinite()) ++nonFinite;
+            std::cout << "  " << std::setw(7) << threads << std::setw(8) << engine.tileCount()
+                      << std::fixed << std::setprecision(4) << std::setw(15) << seconds
+                      << std::scientific << std::setprecision(3) << std::setw(17)
+                      << cellUpdatesPerSecond(engine, steps, seconds)
+                      << std::fixed << std::setprecision(2) << std::setw(10)
+                      << (seconds > 0.0 ? baseline / seconds : 0.0) << std::defaultfloat << std::endl;
+        }
+    }
+    return reportNonFinite(nonFinite);
+}
+
+// --mode=temporal: k = 1, 2, 4, 8 steps per tile pass, checked against plain stepping
+static int runTemporalBenchmark(const benchOptions& opts) {
+    const long steps = opts.steps.front();
+    int nonFinite = 0;
+    std::cout << "Temporal blocking benchmark: " << steps << " steps per run, "
+              << opts.threads << " thread(s)" << std::endl;
+    for (const auto& [name, scenario] : benchScenarios(opts)) {
+        vegetationDense reference(scenario, opts.kernel);
+        reference.setThreads(opts.threads);
+        for (long step = 0; step < steps; ++step) reference.step();
+        if (!reference.allFinite()) ++nonFinite;
+
+        std::cout << name << " (" << scenario.rows << "x" << scenario.cols << ")" << std::endl;
+        std::cout << "  k        seconds   cell-updates/s   est. bytes/update   bit-identical" << std::endl;
+        for (int k : {1, 2, 4, 8}) {
+            vegetationDense engine(scenario, opts.kernel);
+            engine.setThreads(opts.threads);
+            engine.setTemporalBlock(k);
+            auto t0 = std::chrono::steady_clock::now();
+            engine.advance(steps);
+            const double seconds = secondsSince(t0);
+            std::cout << "  " << k
+                      << std::fixed << std::setprecision(4) << std::setw(15) << seconds
+                      << std::scientific << std::setprecision(3) << std::setw(17)
+                      << cellUpdatesPerSecond(engine, steps, seconds)
+                      << std::fixed << std::setprecision(1) << std::setw(20) << engine.bytesPerCellUpdate(k)
+                      << std::setw(16) << (engine.sameState(reference) ? "yes" : "NO")
+                      << std::defaultfloat << std::endl;
+        }
+    }
+    return reportNonFinite(nonFinite);
+}
+
+// --mode=startup: scenario load and engine setup per grid size. The configs use JSON
+// cell_maps; each synthetic size is first written as an NPY plane referenced from
+// scenario.initial. Peak RSS is the process high-water mark, so sizes run smallest first.
+static int runStartupBenchmark(const benchOptions& opts) {
+    const auto dir = std::filesystem::temp_directory_path() / "vegetation_startup";
+    std::filesystem::create_directories(dir);
+    std::cout << "Startup benchmark (NPY scenarios in " << dir.string() << ")" << std::endl;
+    std::cout << "  scenario                                load s    setup s   peak RSS MiB" << std::endl;
+    auto measure = [&](const std::string& label, const std::string& path) {
+        auto t0 = std::chrono::steady_clock::now();
+        const denseScenario scenario = loadDenseScenario(path);
+        const double loadSeconds = secondsSince(t0);
+        t0 = std::chrono::steady_clock::now();
+        const vegetationDense engine(scenario, opts.kernel);
+        const double setupSeconds = secondsSince(t0);
+        std::cout << "  " << std::left << std::setw(36) << label << std::right
+                  << std::fixed << std::setprecision(4) << std::setw(11) << loadSeconds
+                  << std::setw(11) << setupSeconds << std::setprecision(1) << std::setw(15) << peakRSSMiB()
+                  << std::defaultfloat << std::endl;
+    };
+    for (const auto& path : opts.configs) {
+        measure(std::filesystem::path(path).filename().string(), path);
+    }
+
+    for (const auto& [rows, cols] : opts.sizes) {
+        const std::string base = "grid" + std::to_string(rows) + "x" + std::to_string(cols);
+        {
+            std::vector<double> biomass(static_cast<size_t>(rows) * cols);
+            for (size_t k = 0; k < biomass.size(); ++k) biomass[k] = vegetationSeeded(1, k) ? syntheticBiomass : 0.0;
+            writeNpy((dir / (base + "_B.npy")).string(), biomass.data(), rows, cols);
+        }
+        const nlohmann::json config = {
+            {"scenario", {{"shape", {rows, cols}}, {"wrapped", true},
+                          {"initial", {{"format", "npy"}, {"B", base + "_B.npy"}}}}},
+            {"cells", {{"default", {{"model", "vegetation"}, {"state", {{"S", 1.0}, {"B", 0.0}}},
+                                    {"neighborhood", {{{"type", "von_neumann"}, {"range", 1}}}}}}}}};
+        const std::string path = (dir / (base + ".json")).string();
+        std::ofstream(path) << config.dump(2);
+        measure("npy " + std::to_string(rows) + "x" + std::to_string(cols), path);
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    benchOptions opts;
+    std::vector<std::string> configs;
+    bool badOption = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        try {
+            if (arg.rfind("--mode=", 0) == 0) {
+                opts.mode = arg.substr(7);
+            } else if (arg.rfind("--sizes=", 0) == 0) {
+                opts.sizes.clear();
+                for (const auto& n : splitList(arg.substr(8))) opts.sizes.push_back(parseSize(n));
+            } else if (arg.rfind("--steps=", 0) == 0) {
+                opts.steps.clear();
+                for (const auto& n : splitList(arg.substr(8))) opts.steps.push_back(std::stol(n));
+            } else if (arg.rfind("--threads=", 0) == 0) {
+                opts.threads = static_cast<unsigned>(std::stoul(arg.substr(10)));
+            } else if (arg.rfind("--kernel=", 0) == 0) {
+                opts.kernel = arg.substr(9);
+            } else if (arg == "--no-cadmium") {
+                opts.cadmium = false;
+            } else if (arg.rfind("--out=", 0) == 0) {
+                opts.outPath = arg.substr(6);
+            } else if (arg.rfind("--baseline=", 0) == 0) {
+                opts.baselinePath = arg.substr(11);
+            } else if (arg.rfind("--tolerance=", 0) == 0) {
+                opts.tolerance = std::stod(arg.substr(12));
+            } else if (arg.rfind("--", 0) == 0) {
+                std::cerr << "Unknown option " << arg << std::endl;
+                badOption = true;
+            } else {
+                configs.push_back(arg);
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Invalid value in " << arg << std::endl;
+            badOption = true;
+        }
+    }
+    const bool regression = opts.mode == "regression";
+    if (badOption || (!regression && opts.mode != "scaling" && opts.mode != "temporal" && opts.mode != "startup")) {
+        std::cout << "Usage: " << argv[0]
+                  << " [SCENARIO_CONFIG.json ...] [--sizes=512,1024,2048] [--steps=10,50]"
+                  << " [--threads=N] [--kernel=auto|avx512|avx2|scalar]\n"
+                  << "       [--no-cadmium] [--out=bench_results.json] [--baseline=FILE] [--tolerance=0.10]\n"
+                  << "       " << argv[0]
+                  << " --mode=scaling|temporal|startup [SCENARIO_CONFIG.json ...] [--sizes=N|RxC,...]"
+                  << " [--steps=N] [--threads=N] [--kernel=...]" << std::endl;
+        return -1;
+    }
+    if (!configs.empty()) opts.configs = configs;
+    if (opts.sizes.empty()) {
+        if (regression) opts.sizes = {{512, 512}, {1024, 1024}, {2048, 2048}};
+        else if (opts.mode == "startup") opts.sizes = {{1024, 1024}, {2048, 2048}, {4096, 4096}};
+        else opts.sizes = {{4096, 4096}};
+    }
+    if (opts.steps.empty()) opts.steps = regression ? std::vector<long>{10, 50} : std::vector<long>{20};
+
+    if (opts.mode == "scaling") return runScalingBenchmark(opts);
+    if (opts.mode == "temporal") return runTemporalBenchmark(opts);
+    if (opts.mode == "startup") return runStartupBenchmark(opts);
+
+    // Smallest runs first: peak RSS is the process high-water mark
+    std::vector<benchResult> results;
+    for (const auto& path : opts.configs) {
+        const denseScenario scenario = loadDenseScenario(path);
+        const std::string name = std::filesystem::path(path).filename().string();
+        for (long steps : opts.steps) {
+            if (opts.cadmium) results.push_back(benchCadmium(name, path, scenario.rows, scenario.cols, steps));
+            results.push_back(benchDense(name, scenario, steps, opts));
+        }
+    }
+    for (const auto& [rows, cols] : opts.sizes) {
+        const denseScenario scenario = syntheticDenseScenario(rows, cols);
+        for (long steps : opts.steps) {
+            results.push_back(benchDense("synthetic" + std::to_string(rows) + "x" + std::to_string(cols), scenario,
+                                         steps, opts));
+        }
+    }
+
+    std::cout << "  " << std::left << std::setw(runNameWidth) << "run" << std::right
+              << " cell-updates/s  allocs/step   peak RSS MiB   ns/cell-update by phase\n";
+    nlohmann::json out = {{"version", 2},
+                          {"kernel", selectRowKernel(opts.kernel).name},
+                          {"threads", opts.threads},
+                          {"results", nlohmann::json::array()}};
+    int nonFinite = 0;
+    for (const auto& r : results) {
+        std::cout << "  " << std::left << std::setw(runNameWidth) << r.name << std::right
+                  << std::scientific << std::setprecision(3) << std::setw(15) << r.cellUpdatesPerSecond
+                  << std::fixed << std::setprecision(1) << std::setw(13) << r.allocationsPerStep
+                  << std::setw(15) << r.peakRSS << "  ";
+        for (const auto& [phase, ns] : r.phases) std::cout << " " << phase << "=" << std::setprecision(2) << ns;
+        std::cout << std::defaultfloat << (r.finite ? "" : "  NON-FINITE") << "\n";
+        if (!r.finite) ++nonFinite;
+        out["results"].push_back(toJson(r));
+    }
+
+    std::ofstream file(opts.outPath);
+    if (!file.is_open()) {
+        std::cerr << "Error opening results file: " << opts.outPath << std::endl;
+        return 1;
+    }
+    file << out.dump(2) << "\n";
+    std::cout << "Results written to " << opts.outPath << std::endl;
+    if (nonFinite > 0) return reportNonFinite(nonFinite);
+
+    if (!opts.baselinePath.empty()) {
+        std::ifstream in(opts.baselinePath);
+        if (!in.is_open()) {
+            std::cerr << "Error opening baseline file: " << opts.baselinePath << std::endl;
+            return 1;
+        }
+        const int regressions = compareBaseline(out, nlohmann::json::parse(in), opts.tolerance);
+        std::cout << regressions << " regression(s)" << std::endl;
+        return regressions > 0 ? 1 : 0;
+    }
+    return 0;
+}
@@ -0,0 +1,168 @@
+// include/asyncFrameQueue.hpp
+#ifndef CADMIUM_EXAMPLE_CELLDEVS_ASYNC_FRAME_QUEUE_HPP_
+#define CADMIUM_EXAMPLE_CELLDEVS_ASYNC_FRAME_QUEUE_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+//! What the simulation thread does when every frame buffer is still waiting to be written
+enum class backPressure {
+    block,      //!< wait for the writer
+    drop,       //!< discard the new frame
+    decimate    //!< discard it and keep only every 2^k-th frame until the writer catches up
+};
+
+inline backPressure parseBackPressure(const std::string& name) {
+    if (name == "block") return backPressure::block;
+    if (name == "drop") return backPressure::drop;
+    if (name == "decimate") return backPressure::decimate;
+    throw std::invalid_argument("unknown back-pressure policy \"" + name + "\"");
+}
+
+/**
+ * @brief Ring of preallocated frames handed from the simulation thread to a writer thread.
+ * The simulation thread fills the slot returned by acquire() and calls publish();
+ * the writer thread serializes published frames in order through the write callback.
+ * Slots are copies of a prototype frame made once, so steady-state logging does not
+ * allocate as long as the frame type keeps its capacity.
+ */
+template <class Frame>
+class asyncFrameQueue {
+public:
+    asyncFrameQueue(size_t slots, backPressure policy, std::function<void(Frame&)> write,
+                    const Frame& prototype = Frame{})
+        : ring(std::max<size_t>(slots, 1), prototype), policy(policy), write(std::move(write)) {
+        writer = std::thread([this] { writerLoop(); });
+    }
+
+    ~asyncFrameQueue() {
+        close();
+    }
+
+    asyncFrameQueue(const asyncFrameQueue&) = delete;
+    asyncFrameQueue& operator=(const asyncFrameQueue&) = delete;
+
+    //! Slot to fill for the next frame, or nullptr if the policy discards it
+    Frame* acquire() {
+        acquiredAt = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(mutex);
+        ++offered;
+        if (policy == backPressure::decimate && offered % decimation != 0) {
+            return discard();
+        }
+        if (filled == ring.size()) {
+            if (policy == backPressure::block) {
+                notFull.wait(lock, [this] { return filled < ring.size(); });
+            } else {
+                if (policy == backPressure::decimate) decimation = std::min<uint64_t>(decimation * 2, 64);
+                return discard();
+            }
+        }
+        return &ring[head];
+    }
+
+    //! Simulation-thread time spent collecting the next frame before acquire(), e.g. inside
+    //! logger callbacks; it is added to that frame's reported overhead
+    void addCollectionTime(std::chrono::steady_clock::duration elapsed) {
+        collecting += elapsed;
+    }
+
+    //! Hand the slot returned by acquire() to the writer thread
+    void publish() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            head = (head + 1) % ring.size();
+            ++filled;
+            ++published;
+        }
+        notEmpty.notify_one();
+        account();
+    }
+
+    //! Write every published frame and stop the writer thread
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (closing) return;
+            closing = true;
+        }
+        notEmpty.notify_one();
+        writer.join();
+    }
+
+    //! Frames published/dropped and the time the simulation thread spent per frame
+    void report(std::ostream& os, const std::string& label) const {
+        const uint64_t frames = published + dropped;
+        os << label << ": " << published << " frame(s) written, " << dropped << " dropped; "
+           << "simulation-thread overhead " << std::fixed << std::setprecision(1)
+           << (frames > 0 ? 1e6 * overheadTotal / static_cast<double>(frames) : 0.0) << " us/frame mean, "
+           << 1e6 * overheadMax << " us max" << std::defaultfloat << std::endl;
+    }
+
+private:
+    std::vector<Frame> ring;
+    backPressure policy;
+    std::function<void(Frame&)> write;
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    size_t head = 0;        //!< next slot the simulation thread fills
+    size_t tail = 0;        //!< next slot the writer serializes
+    size_t filled = 0;
+    bool closing = false;
+    uint64_t offered = 0;
+    uint64_t decimation = 1;
+    uint64_t published = 0;
+    uint64_t dropped = 0;
+    std::chrono::steady_clock::time_point acquiredAt;
+    std::chrono::steady_clock::duration collecting{};
+    double overheadTotal = 0.0;
+    double overheadMax = 0.0;
+
+    Frame* discard() {
+        ++dropped;
+        account();
+        return nullptr;
+    }
+
+    void account() {
+        const double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - acquiredAt + collecting).count();
+        collecting = {};
+        overheadTotal += seconds;
+        overheadMax = std::max(overheadMax, seconds);
+    }
+
+    void writerLoop() {
+        for (;;) {
+            Frame* frame;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                notEmpty.wait(lock, [this] { return filled > 0 || closing; });
+                if (filled == 0) return;
+                frame = &ring[tail];
+            }
+            write(*frame);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                tail = (tail + 1) % ring.size();
+                --filled;
+                if (policy == backPressure::decimate && filled == 0 && decimation > 1) decimation /= 2;
+            }
+            notFull.notify_one();
+        }
+    }
+};
+
+#endif // CADMIUM_EXAMPLE_CELLDEVS_ASYNC_FRAME_QUEUE_HPP_
@@ -6,12 +6,15 @@
 #include <cadmium/modeling/celldevs/grid/cell.hpp>
 #include <cadmium/modeling/celldevs/grid/config.hpp>
 #include "vegetationState.hpp"
+#include "vegetationParams.hpp"
+#include "vegetationProfile.hpp"
 
 using namespace cadmium::celldevs;
 
 /**
  * @brief A GridCell implementation of the Rietkerk Turing vegetation model.
  * State variables: S (soil moisture), B (plant biomass).
+ * Parameters come from the optional "parameters" object of the cell configuration.
  */
 class vegetationCell : public GridCell<vegetationState, double> {
 public:
@@ -20,59 +23,32 @@ public:
         const std::shared_ptr<const GridCellConfig<vegetationState, double>>& config
     ) : GridCell<vegetationState, double>(id, config)
       , cell_id(id)
-    {}
+      , params(vegetationParamsFromConfig(config->rawCellConfig))
+    {
+        // Without a configured state the cell takes the random default state of its row-major
+        // index, as the dense engine does, whatever order the cells are built in
+        if (!config->rawCellConfig.contains("state")) {
+            const auto& scenario = *config->scenario;
+            const auto index = static_cast<uint64_t>(id[0] - scenario.origin[0]) * static_cast<uint64_t>(scenario.shape[1])
+                             + static_cast<uint64_t>(id[1] - scenario.origin[1]);
+            *this->state.cellState = vegetationDefaultState(vegetationDefaultSeed, index);
+        }
+    }
     //std::cerr << "Cell ["<<cell_id[0]<<","<<cell_id[1]<<"] neighbors=" << neighborhood.size() << "\n";
 
+    //! Neighborhood as Cadmium passes it to localComputation
+    using neighborhoodMap = std::unordered_map<std::vector<int>, NeighborData<vegetationState, double>>;
+
     [[nodiscard]] vegetationState localComputation(
         vegetationState state,
-        const std::unordered_map<std::vector<int>, NeighborData<vegetationState, double>>& neighborhood
+        const neighborhoodMap& neighborhood
     ) const override {
+        profileScope profile(profilePhase::localComputation);
         // 在 localComputation 的开头加：
 
 //state.S = std::max(0.0, state.S);
 //state.B = std::max(0.0, state.B);
-        // Model parameters
-        const double gamma = 1.6;
-        const double sigma = 1.6;
-        const double mu    = 0.2;
-        const double pho   = 1.5;
-        const double delta = 100.0;
-        const double p     = 0.15;
-        const double beta  = 3.0;
-        const double dt    = 0.0005;  // Cadmium time-step
-        // Physical grid spacing: length=128 over n=256 cells => dx=0.5
-        const double dX2   = 0.5 * 0.5;
-        double sb0 = state.S - beta * state.B;
-        // Compute discrete Laplacian for S - beta*B and for B
-        double lap_Sb = 0.0;
-        double lap_B  = 0.0;
-        for (const auto& kv : neighborhood) {
-            const auto& nb = *(kv.second.state);
-            lap_Sb += (nb.S - beta * nb.B);
-            lap_B  += nb.B;
-        }
-        // subtract central cell
-        double N = static_cast<double>(neighborhood.size());
-        lap_Sb = (lap_Sb - N * sb0) / dX2;
-        lap_B  = (lap_B  - N * state.B) / dX2;
-        
-
-        // Reaction-diffusion equations
-        double dSdt = p
-            - (1.0 - pho * state.B) * state.S
-            - state.S * state.S * state.B
-            + delta * lap_Sb;
-        double dBdt = (gamma * state.S / (1.0 + sigma * state.S)) * state.B
-            - state.B * state.B
-            - mu * state.B
-            + lap_B;
-            if (!std::isfinite(dSdt) || !std::isfinite(dBdt)) {
-                std::cerr<<"  >>> bad deriv at cell "<<cell_id[0]<<","<<cell_id[1]
-                         <<": dSdt="<<dSdt<<", dBdt="<<dBdt<<"\n";
-            }
-        // Euler integration
-        state.S += dSdt * dt;
-        state.B += dBdt * dt;
+        state = update(state, neighborhood, params);
         if (!std::isfinite(state.S) || !std::isfinite(state.B)) {
             std::cerr<<"  >>> overflow after update at cell "<<cell_id[0]<<","<<cell_id[1]
                      <<": S="<<state.S<<", B="<<state.B<<"\n";
@@ -80,12 +56,32 @@ public:
         return state;
     }
 
+    /**
+     * @brief The localComputation update without a coupled model around it.
+     * Sums S - beta*B and B over the neighborhood (in map order) and takes one
+     * vegetationEuler step, the same step the dense row kernels take.
+     */
+    [[nodiscard]] static vegetationState update(vegetationState state, const neighborhoodMap& neighborhood,
+                                                const vegetationParams& params) {
+        double sumSb = 0.0;
+        double sumB  = 0.0;
+        for (const auto& kv : neighborhood) {
+            const auto& nb = *(kv.second.state);
+            sumSb += (nb.S - params.beta * nb.B);
+            sumB  += nb.B;
+        }
+        vegetationEuler(state.S, state.B, sumSb, sumB, static_cast<double>(neighborhood.size()), params,
+                        state.S, state.B);
+        return state;
+    }
+
     [[nodiscard]] double outputDelay(const vegetationState&) const override {
         return 1;
     }
 
 private:
     std::vector<int> cell_id;
+    vegetationParams params;
 };
 
 #endif // CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_HPP_
\ No newline at end of file
@@ -0,0 +1,170 @@
+// include/vegetationCheckpoint.hpp
+#ifndef CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_CHECKPOINT_HPP_
+#define CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_CHECKPOINT_HPP_
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+ * Checkpoint file (.ckpt), native little-endian:
+ *
+ *   char[8] magic "VEGCKPT1"
+ *   uint32  version (1)
+ *   uint32  rows, cols
+ *   int64   step                 Euler steps taken
+ *   double  time                 simulation time
+ *   uint64  log bytes            size of the run's log once every frame up to `time` was written
+ *   double  S[rows * cols], B[rows * cols]
+ *   uint64  FNV-1a hash of everything above
+ */
+
+//! Full grid state needed to continue a run bit-exactly
+struct vegetationCheckpoint {
+    int64_t step = 0;
+    double time = 0.0;
+    uint64_t logBytes = 0;
+    uint32_t rows = 0;
+    uint32_t cols = 0;
+    std::vector<double> S;
+    std::vector<double> B;
+
+    vegetationCheckpoint() = default;
+    vegetationCheckpoint(uint32_t r, uint32_t c)
+        : rows(r), cols(c), S(static_cast<size_t>(r) * c), B(static_cast<size_t>(r) * c) {}
+};
+
+constexpr char checkpointMagic[8] = {'V', 'E', 'G', 'C', 'K', 'P', 'T', '1'};
+constexpr uint32_t checkpointVersion = 1;
+
+/**
+ * @brief Log size after each written frame, handed from the log writer thread to a checkpoint.
+ * The simulation thread asks for the size once the frames it has published so far are
+ * written; it cannot have been overtaken, so the size is known now or arrives with one of
+ * the frames still queued. The checkpoint writer waits for it, not the simulation thread.
+ */
+class checkpointLogSize {
+public:
+    explicit checkpointLogSize(uint64_t bytes) : bytes(bytes) {}
+
+    //! Log writer thread: the next frame is written and flushed, leaving the log `size` bytes long
+    void frameWritten(uint64_t size) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++written;
+            bytes = size;
+            if (slot != nullptr && written == target) {
+                *slot = size;
+                slot = nullptr;
+            }
+        }
+        ready.notify_all();
+    }
+
+    //! Simulation thread: store the log size in *into once `frames` frames have been written
+    void request(uint64_t frames, uint64_t* into) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (written == frames) {
+            *into = bytes;
+        } else {
+            target = frames;
+            slot = into;
+        }
+    }
+
+    //! Checkpoint writer thread: wait until the requested size is stored
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [this] { return slot == nullptr; });
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable ready;
+    uint64_t written = 0;
+    uint64_t bytes;
+    uint64_t target = 0;
+    uint64_t* slot = nullptr;
+};
+
+inline uint64_t fnv1a(const void* data, size_t n, uint64_t hash = 14695981039346656037ull) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    for (size_t k = 0; k < n; ++k) {
+        hash = (hash ^ p[k]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief Write a checkpoint atomically.
+ * The file is written next to `path` under a temporary name and renamed over it
+ * once complete, so a crash mid-write leaves the previous checkpoint intact.
+ */
+inline void writeCheckpointFile(const std::string& path, const vegetationCheckpoint& ckpt) {
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) throw std::runtime_error("checkpoint: cannot open " + tmp);
+        uint64_t hash = fnv1a(nullptr, 0);
+        auto put = [&](const void* data, size_t n) {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(n));
+            hash = fnv1a(data, n, hash);
+        };
+        const uint32_t version = checkpointVersion;
+        put(checkpointMagic, sizeof(checkpointMagic));
+        put(&version, sizeof(version));
+        put(&ckpt.rows, sizeof(ckpt.rows));
+        put(&ckpt.cols, sizeof(ckpt.cols));
+        put(&ckpt.step, sizeof(ckpt.step));
+        put(&ckpt.time, sizeof(ckpt.time));
+        put(&ckpt.logBytes, sizeof(ckpt.logBytes));
+        put(ckpt.S.data(), ckpt.S.size() * sizeof(double));
+        put(ckpt.B.data(), ckpt.B.size() * sizeof(double));
+        out.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+        out.close();
+        if (!out) throw std::runtime_error("checkpoint: write failed for " + tmp);
+    }
+    std::filesystem::rename(tmp, path);
+}
+
+//! Read and verify a checkpoint written by writeCheckpointFile()
+inline vegetationCheckpoint readCheckpointFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) throw std::runtime_error("checkpoint: cannot open " + path);
+    uint64_t hash = fnv1a(nullptr, 0);
+    auto get = [&](void* data, size_t n) {
+        in.read(static_cast<char*>(data), static_cast<std::streamsize>(n));
+        if (!in) throw std::runtime_error("checkpoint: truncated file " + path);
+        hash = fnv1a(data, n, hash);
+    };
+    char magic[sizeof(checkpointMagic)];
+    uint32_t version = 0;
+    get(magic, sizeof(magic));
+    get(&version, sizeof(version));
+    if (std::memcmp(magic, checkpointMagic, sizeof(magic)) != 0 || version != checkpointVersion) {
+        throw std::runtime_error("checkpoint: " + path + " is not a version " +
+                                 std::to_string(checkpointVersion) + " checkpoint");
+    }
+    vegetationCheckpoint ckpt;
+    get(&ckpt.rows, sizeof(ckpt.rows));
+    get(&ckpt.cols, sizeof(ckpt.cols));
+    get(&ckpt.step, sizeof(ckpt.step));
+    get(&ckpt.time, sizeof(ckpt.time));
+    get(&ckpt.logBytes, sizeof(ckpt.logBytes));
+    ckpt.S.resize(static_cast<size_t>(ckpt.rows) * ckpt.cols);
+    ckpt.B.resize(ckpt.S.size());
+    get(ckpt.S.data(), ckpt.S.size() * sizeof(double));
+    get(ckpt.B.data(), ckpt.B.size() * sizeof(double));
+    uint64_t stored = 0;
+    in.read(reinterpret_cast<char*>(&stored), sizeof(stored));
+    if (!in || stored != hash) throw std::runtime_error("checkpoint: checksum mismatch in " + path);
+    return ckpt;
+}
+
+#endif // CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_CHECKPOINT_HPP_
@@ -0,0 +1,619 @@
+// include/vegetationDense.hpp
+#ifndef CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_DENSE_HPP_
+#define CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_DENSE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "vegetationState.hpp"
+#include "vegetationParams.hpp"
+#include "vegetationInitial.hpp"
+#include "vegetationKernel.hpp"
+#include "vegetationProfile.hpp"
+#include "workStealingPool.hpp"
+
+//! One run of an ensemble: its parameters and, if seed >= 0, a random initial state
+struct denseMember {
+    vegetationParams params;
+    long seed = -1;     //!< -1 keeps the scenario initial state, otherwise the random default state of this stream
+};
+
+//! Grid layout and initial state read from the same scenario JSON as GridCellDEVSCoupled
+struct denseScenario {
+    int rows = 0;                               //!< scenario.shape[0]
+    int cols = 0;                               //!< scenario.shape[1]
+    bool wrapped = false;                       //!< scenario.wrapped
+    std::vector<std::pair<int, int>> offsets;   //!< relative neighborhood, including the cell itself
+    std::vector<vegetationState> initial;       //!< row-major initial states (rows * cols)
+    int temporalBlock = 1;                      //!< scenario.temporal_block: steps per tile pass
+    uint64_t seed = 0;                          //!< scenario.seed: stream of the random default state
+    vegetationParams params;                    //!< cells.default.parameters
+    std::vector<denseMember> ensemble;          //!< top-level "ensemble" list (empty for a single run)
+};
+
+//! Relative neighbors of one "neighborhood" entry, following the Cadmium grid conventions
+inline void addDenseNeighborhood(const nlohmann::json& entry, std::vector<std::pair<int, int>>& offsets) {
+    const std::string type = entry.at("type").get<std::string>();
+    if (type == "moore" || type == "von_neumann") {
+        const int range = entry.value("range", 1);
+        for (int di = -range; di <= range; ++di) {
+            for (int dj = -range; dj <= range; ++dj) {
+                if (type == "von_neumann" && std::abs(di) + std::abs(dj) > range) continue;
+                offsets.emplace_back(di, dj);
+            }
+        }
+    } else if (type == "relative") {
+        for (const auto& nb : entry.at("neighbors")) {
+            offsets.emplace_back(nb.at(0).get<int>(), nb.at(1).get<int>());
+        }
+    } else {
+        throw std::invalid_argument("dense engine: unsupported neighborhood type \"" + type + "\"");
+    }
+}
+
+/**
+ * @brief Parse a scenario JSON file into a denseScenario (only the "vegetation" cell model is supported).
+ * The initial state is cells.default.state (or, without one, the random default state
+ * of stream scenario.seed), then the scenario.initial layers (see vegetationInitial.hpp),
+ * then every cell_map entry.
+ */
+inline denseScenario loadDenseScenario(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        throw std::runtime_error("dense engine: cannot open scenario file " + path);
+    }
+    // Parsing from one contiguous buffer is much faster than through the stream adapter
+    const std::string text{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    const nlohmann::json config = nlohmann::json::parse(text);
+    const auto& scenario = config.at("scenario");
+    const auto& shape = scenario.at("shape");
+    if (shape.size() != 2) {
+        throw std::invalid_argument("dense engine: only 2D scenarios are supported");
+    }
+
+    denseScenario sc;
+    sc.rows = shape.at(0).get<int>();
+    sc.cols = shape.at(1).get<int>();
+    sc.wrapped = scenario.value("wrapped", false);
+    sc.temporalBlock = scenario.value("temporal_block", 1);
+    sc.seed = scenario.value("seed", uint64_t{0});
+    std::vector<int> origin = scenario.value("origin", std::vector<int>{0, 0});
+
+    const auto& cells = config.at("cells");
+    const nlohmann::json& defaults = cells.at("default");
+    if (defaults.value("model", std::string{}) != "vegetation") {
+        throw std::bad_typeid();
+    }
+    sc.params = vegetationParamsFromConfig(defaults);
+    for (const auto& entry : defaults.at("neighborhood")) {
+        addDenseNeighborhood(entry, sc.offsets);
+    }
+    std::sort(sc.offsets.begin(), sc.offsets.end());
+    sc.offsets.erase(std::unique(sc.offsets.begin(), sc.offsets.end()), sc.offsets.end());
+
+    const size_t cellCount = static_cast<size_t>(sc.rows) * sc.cols;
+    if (defaults.contains("state")) {
+        sc.initial.assign(cellCount, defaults.at("state").get<vegetationState>());
+    } else {
+        sc.initial.reserve(cellCount);
+        for (size_t k = 0; k < cellCount; ++k) sc.initial.push_back(vegetationDefaultState(sc.seed, k));
+    }
+    if (scenario.contains("initial")) {
+        const auto& layers = scenario.at("initial");
+        const std::filesystem::path baseDir = std::filesystem::path(path).parent_path();
+        for (const auto& layer : layers.is_array() ? layers : nlohmann::json::array({layers})) {
+            applyInitialLayer(layer, baseDir, sc.rows, sc.cols, sc.initial);
+        }
+    }
+
+    // Every other entry is patched over "default" and applied to its cell_map, as Cadmium does
+    for (const auto& [name, cellConfig] : cells.items()) {
+        if (name == "default") continue;
+        nlohmann::json merged = defaults;
+        merged.merge_patch(cellConfig);
+        if (merged.value("model", std::string{}) != "vegetation") {
+            throw std::bad_typeid();
+        }
+        if (cellConfig.contains("parameters")) {
+            throw std::invalid_argument("dense engine: per-cell parameters (cells." + name + ") are not supported");
+        }
+        const auto state = merged.at("state").get<vegetationState>();
+        for (const auto& id : cellConfig.at("cell_map")) {
+            const int i = id.at(0).get<int>() - origin[0];
+            const int j = id.at(1).get<int>() - origin[1];
+            if (i < 0 || i >= sc.rows || j < 0 || j >= sc.cols) {
+                throw std::out_of_range("dense engine: cell_map entry outside scenario shape");
+            }
+            sc.initial[static_cast<size_t>(i) * sc.cols + j] = state;
+        }
+    }
+
+    // Ensemble members patch the default parameters and may draw their own initial state
+    for (const auto& entry : config.value("ensemble", nlohmann::json::array())) {
+        denseMember member{sc.params};
+        if (entry.contains("parameters")) {
+            from_json(entry.at("parameters"), member.params);
+        }
+        member.seed = entry.value("seed", -1L);
+        sc.ensemble.push_back(member);
+    }
+    return sc;
+}
+
+//! Biomass of the seeded cells of a synthetic grid. With the default parameters the
+//! scenario default of 2.0 diverges on some grids (25 non-finite cells at t=20 on 1024x1024);
+//! 1.0 stays finite.
+constexpr double syntheticBiomass = 1.0;
+
+//! Synthetic wrapped grid for benchmarks: von Neumann range 1, B = syntheticBiomass on the
+//! cells of stream `seed` that the random default state would seed
+inline denseScenario syntheticDenseScenario(int rows, int cols, uint64_t seed = 1) {
+    denseScenario sc;
+    sc.rows = rows;
+    sc.cols = cols;
+    sc.wrapped = true;
+    sc.seed = seed;
+    addDenseNeighborhood({{"type", "von_neumann"}, {"range", 1}}, sc.offsets);
+    sc.initial.reserve(static_cast<size_t>(rows) * cols);
+    for (size_t k = 0; k < static_cast<size_t>(rows) * cols; ++k) {
+        sc.initial.emplace_back(1.0, vegetationSeeded(seed, k) ? syntheticBiomass : 0.0);
+    }
+    return sc;
+}
+
+/**
+ * @brief Structure-of-arrays stepping engine for the Rietkerk vegetation model.
+ * S and B live in two double-buffered planes padded with a halo as wide as the
+ * neighborhood range. Each step is one fused Laplacian-plus-reaction sweep that
+ * evaluates the vegetationCell::localComputation update row by row through the
+ * runtime-selected SIMD kernel (see vegetationKernel.hpp).
+ * The sweep is split into cache-sized tiles that run on an optional work-stealing pool.
+ * Non-wrapped borders keep a zero halo and a per-cell neighbor count, so the
+ * Laplacian only sees in-grid neighbors, matching the Cadmium neighborhood.
+ * An ensemble of M runs shares the layout: every plane holds the M members of a
+ * cell next to each other (element cell * M + m), so a row kernel vectorizes
+ * across members and neighbors with per-member parameter lanes.
+ */
+class vegetationDense {
+public:
+    //! Single run with the scenario parameters and initial state
+    explicit vegetationDense(const denseScenario& scenario, const std::string& kernelName = "auto")
+        : vegetationDense(scenario, {denseMember{scenario.params}}, kernelName) {}
+
+    //! Ensemble run: one interleaved member per entry, all on the scenario grid
+    vegetationDense(const denseScenario& scenario, const std::vector<denseMember>& ensemble,
+                    const std::string& kernelName = "auto")
+        : nRows(scenario.rows), nCols(scenario.cols), wrapped(scenario.wrapped)
+        , nMembers(std::max<size_t>(ensemble.size(), 1)), lanes(memberParams(ensemble))
+        , kernel(selectRowKernel(kernelName)) {
+        profileScope profile(profilePhase::modelBuild);
+        for (const auto& [di, dj] : scenario.offsets) {
+            halo = std::max({halo, std::abs(di), std::abs(dj)});
+        }
+        pitch = nCols + 2 * halo;
+        const size_t padded = static_cast<size_t>(nRows + 2 * halo) * pitch * nMembers;
+        for (int k = 0; k < 2; ++k) {
+            S[k].assign(padded, 0.0);
+            B[k].assign(padded, 0.0);
+        }
+        relOffsets = scenario.offsets;
+        temporalBlock = std::max(1, scenario.temporalBlock);
+        for (const auto& [di, dj] : scenario.offsets) {
+            offsets.push_back((static_cast<long>(di) * pitch + dj) * static_cast<long>(nMembers));
+        }
+
+        count.assign(cells() * nMembers, 0.0);
+        for (int i = 0; i < nRows; ++i) {
+            for (int j = 0; j < nCols; ++j) {
+                int n = 0;
+                for (const auto& [di, dj] : scenario.offsets) {
+                    const bool inside = i + di >= 0 && i + di < nRows && j + dj >= 0 && j + dj < nCols;
+                    if (wrapped || inside) ++n;
+                }
+                const size_t c = static_cast<size_t>(i) * nCols + j;
+                std::fill_n(count.data() + c * nMembers, nMembers, static_cast<double>(n));
+            }
+        }
+        for (size_t m = 0; m < nMembers; ++m) {
+            const long seed = m < ensemble.size() ? ensemble[m].seed : -1;
+            if (seed < 0) {
+                for (int i = 0; i < nRows; ++i) {
+                    for (int j = 0; j < nCols; ++j) {
+                        const auto& st = scenario.initial[static_cast<size_t>(i) * nCols + j];
+                        S[0][element(i, j, m)] = st.S;
+                        B[0][element(i, j, m)] = st.B;
+                    }
+                }
+            } else {
+                for (int i = 0; i < nRows; ++i) {
+                    for (int j = 0; j < nCols; ++j) {
+                        const uint64_t cell = static_cast<uint64_t>(i) * nCols + j;
+                        S[0][element(i, j, m)] = 1.0;
+                        B[0][element(i, j, m)] = vegetationSeeded(static_cast<uint64_t>(seed), cell) ? 2.0 : 0.0;
+                    }
+                }
+            }
+        }
+        buildTiles(1);
+    }
+
+    [[nodiscard]] int rows() const { return nRows; }
+    [[nodiscard]] int cols() const { return nCols; }
+    [[nodiscard]] size_t cells() const { return static_cast<size_t>(nRows) * nCols; }
+    [[nodiscard]] size_t members() const { return nMembers; }
+    [[nodiscard]] double soil(int i, int j, size_t m = 0) const { return S[cur][element(i, j, m)]; }
+    [[nodiscard]] double biomass(int i, int j, size_t m = 0) const { return B[cur][element(i, j, m)]; }
+    [[nodiscard]] const vegetationParams& params(size_t m = 0) const { return lanes.members[m]; }
+
+    [[nodiscard]] const std::string& kernelName() const { return kernel.name; }
+
+    //! Run the sweep on n threads (work-stealing over tiles); 1 keeps it on the caller
+    void setThreads(unsigned n) {
+        pool = (n > 1) ? std::make_unique<workStealingPool>(n) : nullptr;
+        buildTiles(threads());
+    }
+
+    [[nodiscard]] size_t tileCount() const { return tiles.size(); }
+
+    [[nodiscard]] unsigned threads() const { return pool ? pool->size() : 1; }
+
+    //! Advance every cell by one Euler step (one Cadmium time unit)
+    void step() {
+        {
+            profileScope profile(profilePhase::halo);
+            exchangeHalo();
+        }
+        profileScope profile(profilePhase::sweep);
+        std::atomic<int> badRows{0};
+        auto sweepTile = [&](size_t t) {
+            const tile& tl = tiles[t];
+            for (int i = tl.i0; i < tl.i1; ++i) {
+                const size_t c = element(i, tl.j0, 0);
+                const vegetationRow row{S[cur].data() + c, B[cur].data() + c,
+                                        count.data() + (static_cast<size_t>(i) * nCols + tl.j0) * nMembers,
+                                        S[1 - cur].data() + c, B[1 - cur].data() + c,
+                                        offsets.data(), offsets.size(),
+                                        (tl.j1 - tl.j0) * static_cast<int>(nMembers)};
+                if (!kernel.kernel(row, lanes)) {
+                    badRows.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        };
+        if (pool) {
+            pool->run(tiles.size(), sweepTile);
+        } else {
+            for (size_t t = 0; t < tiles.size(); ++t) sweepTile(t);
+        }
+        cur = 1 - cur;
+        if (badRows.load() > 0) {
+            std::cerr << "  >>> non-finite state in " << badRows.load() << " tile row(s)\n";
+        }
+    }
+
+    //! Steps each tile advances per memory pass in advance(); 1 disables temporal blocking
+    void setTemporalBlock(int k) { temporalBlock = std::max(1, k); }
+
+    [[nodiscard]] int temporalBlockSteps() const { return temporalBlock; }
+
+    //! Advance `steps` Euler steps, up to temporalBlock of them per tile pass
+    void advance(long steps) {
+        while (steps > 0) {
+            const int k = static_cast<int>(std::min<long>(steps, temporalBlock));
+            if (k == 1) step();
+            else blockStep(k);
+            steps -= k;
+        }
+    }
+
+    /**
+     * @brief Estimated main-memory traffic per cell update for k steps per pass.
+     * A plain sweep reads S, B and the neighbor count and writes S and B once per
+     * step (neighbor rows are assumed cache-resident). A blocked pass reads S, B and
+     * the count (non-wrapped grids) over the tile widened by (k-1)*range once, writes
+     * the tile interior once, and zero-fills the scratch cells that fall outside a
+     * non-wrapped grid; the scratch traffic between the k steps is assumed to stay
+     * in cache. Ensemble members scale traffic and updates alike, so this is per member too.
+     */
+    [[nodiscard]] double bytesPerCellUpdate(int k) const {
+        if (k <= 1) return 5.0 * sizeof(double);
+        const int H = (k - 1) * halo;
+        double bytes = 0.0;
+        for (const auto& tl : tiles) {
+            const double widened = static_cast<double>(tl.i1 - tl.i0 + 2 * H) * (tl.j1 - tl.j0 + 2 * H);
+            int ra = tl.i0 - H, rb = tl.i1 + H, ca = tl.j0 - H, cb = tl.j1 + H;
+            if (!wrapped) {
+                ra = std::max(ra, 0); rb = std::min(rb, nRows);
+                ca = std::max(ca, 0); cb = std::min(cb, nCols);
+            }
+            const double region = static_cast<double>(rb - ra) * (cb - ca);
+            bytes += (wrapped ? 2.0 : 3.0) * sizeof(double) * region;
+            bytes += 4.0 * sizeof(double) * (widened - region);
+            bytes += 2.0 * sizeof(double) * (tl.i1 - tl.i0) * (tl.j1 - tl.j0);
+        }
+        return bytes / (static_cast<double>(cells()) * k);
+    }
+
+    //! True if both engines hold bit-identical S and B planes for every member
+    [[nodiscard]] bool sameState(const vegetationDense& other) const {
+        if (other.nRows != nRows || other.nCols != nCols || other.nMembers != nMembers) return false;
+        for (int i = 0; i < nRows; ++i) {
+            for (int j = 0; j < nCols; ++j) {
+                for (size_t m = 0; m < nMembers; ++m) {
+                    if (soil(i, j, m) != other.soil(i, j, m) || biomass(i, j, m) != other.biomass(i, j, m)) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    //! True when S and B are finite in every cell of every member
+    [[nodiscard]] bool allFinite() const {
+        for (int i = 0; i < nRows; ++i) {
+            for (int j = 0; j < nCols; ++j) {
+                for (size_t m = 0; m < nMembers; ++m) {
+                    if (!std::isfinite(soil(i, j, m)) || !std::isfinite(biomass(i, j, m))) return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    //! Copy every stride-th row and column of member m's S and B into row-major buffers (resized to fit)
+    void exportPlanes(std::vector<double>& soilOut, std::vector<double>& biomassOut, int stride = 1,
+                      size_t m = 0) const {
+        const int rowsOut = (nRows + stride - 1) / stride;
+        const int colsOut = (nCols + stride - 1) / stride;
+        soilOut.resize(static_cast<size_t>(rowsOut) * colsOut);
+        biomassOut.resize(static_cast<size_t>(rowsOut) * colsOut);
+        for (int i = 0; i < rowsOut; ++i) {
+            const double* s = S[cur].data() + element(i * stride, 0, m);
+            const double* b = B[cur].data() + element(i * stride, 0, m);
+            const size_t step = static_cast<size_t>(stride) * nMembers;
+            double* sOut = soilOut.data() + static_cast<size_t>(i) * colsOut;
+            double* bOut = biomassOut.data() + static_cast<size_t>(i) * colsOut;
+            for (int j = 0; j < colsOut; ++j) {
+                sOut[j] = s[j * step];
+                bOut[j] = b[j * step];
+            }
+        }
+    }
+
+    //! Overwrite member m's S and B from row-major rows * cols buffers (e.g. a checkpoint)
+    void importPlanes(const std::vector<double>& soilIn, const std::vector<double>& biomassIn, size_t m = 0) {
+        if (soilIn.size() != cells() || biomassIn.size() != cells()) {
+            throw std::invalid_argument("dense engine: plane size does not match the grid");
+        }
+        for (int i = 0; i < nRows; ++i) {
+            for (int j = 0; j < nCols; ++j) {
+                S[cur][element(i, j, m)] = soilIn[static_cast<size_t>(i) * nCols + j];
+                B[cur][element(i, j, m)] = biomassIn[static_cast<size_t>(i) * nCols + j];
+            }
+        }
+    }
+
+private:
+    int nRows;
+    int nCols;
+    bool wrapped;
+    int halo = 0;
+    int pitch = 0;
+    int cur = 0;
+    size_t nMembers = 1;
+    vegetationLanes lanes;
+    vegetationKernelInfo kernel;
+    int temporalBlock = 1;
+    std::vector<std::pair<int, int>> relOffsets;
+    std::vector<long> offsets;     //!< neighbor offsets in padded-plane elements
+    std::vector<double> count;     //!< in-grid neighbor count per cell and member
+    std::vector<double> wrappedCount;   //!< one row of full-neighborhood counts for blocked passes on wrapped grids
+    std::vector<double> S[2];
+    std::vector<double> B[2];
+
+    //! Half-open block of interior cells swept as one task
+    struct tile {
+        int i0, i1, j0, j1;
+    };
+    static constexpr int tileRows = 64;     //!< 64 x 256 doubles per plane: ~128 KiB, fits L2 with halo rows
+    static constexpr int tileCols = 256;
+    static constexpr int minTileRows = 4;   //!< smallest tile when a small grid is split for many workers
+    static constexpr int minTileCols = 16;
+    static constexpr int tilesPerWorker = 4;
+    std::vector<tile> tiles;
+    std::unique_ptr<workStealingPool> pool;
+
+    [[nodiscard]] size_t index(int i, int j) const {
+        return static_cast<size_t>(i + halo) * pitch + (j + halo);
+    }
+
+    [[nodiscard]] size_t element(int i, int j, size_t m) const {
+        return index(i, j) * nMembers + m;
+    }
+
+    /**
+     * @brief Split the grid into cache-sized tiles, smaller if the grid is too small to give
+     * every worker several of them: tile rows are halved first (rows stay contiguous), then
+     * tile columns, until there are tilesPerWorker tiles per worker or the minimum size is hit.
+     */
+    void buildTiles(unsigned workers) {
+        // Keep a tile's row span near tileCols elements however many members share a cell
+        int height = tileRows;
+        int width = std::max(minTileCols, tileCols / static_cast<int>(nMembers));
+        const size_t wanted = workers > 1 ? static_cast<size_t>(workers) * tilesPerWorker : 1;
+        auto countTiles = [&] {
+            return static_cast<size_t>((nRows + height - 1) / height) * ((nCols + width - 1) / width);
+        };
+        while (countTiles() < wanted && (height > minTileRows || width > minTileCols)) {
+            if (height > minTileRows) height = std::max(minTileRows, height / 2);
+            else width = std::max(minTileCols, width / 2);
+        }
+        tiles.clear();
+        for (int i0 = 0; i0 < nRows; i0 += height) {
+            for (int j0 = 0; j0 < nCols; j0 += width) {
+                tiles.push_back({i0, std::min(i0 + height, nRows), j0, std::min(j0 + width, nCols)});
+            }
+        }
+    }
+
+    static std::vector<vegetationParams> memberParams(const std::vector<denseMember>& ensemble) {
+        std::vector<vegetationParams> params;
+        for (const auto& member : ensemble) params.push_back(member.params);
+        return params.empty() ? std::vector<vegetationParams>{vegetationParams{}} : params;
+    }
+
+    /**
+     * @brief Temporally blocked pass: k Euler steps per tile per memory pass.
+     * Each tile advances a shrinking trapezoid, step s covering the tile widened by
+     * (k-1-s)*range. The first step reads the current planes in place (after the usual
+     * halo exchange, splitting rows where a wrapped grid wraps) and the last step writes
+     * the tile interior straight into the next planes; only the steps in between use
+     * thread-local scratch, whose out-of-grid cells are zeroed on non-wrapped grids.
+     * Neighbor counts are read in place too: the count plane on non-wrapped grids and
+     * one constant row on wrapped grids. Every cell sees the same neighbor values,
+     * offset order and kernel as in step(), so results are bit-identical.
+     */
+    void blockStep(int k) {
+        {
+            profileScope profile(profilePhase::halo);
+            exchangeHalo();
+        }
+        profileScope profile(profilePhase::sweep);
+        const int H = (k - 1) * halo;   // widening of the first step's output, the scratch region
+        const size_t M = nMembers;
+        if (wrapped) {
+            // Every cell of a wrapped grid has the full neighborhood
+            size_t widest = 0;
+            for (const auto& tl : tiles) widest = std::max<size_t>(widest, tl.j1 - tl.j0 + 2 * H);
+            if (wrappedCount.size() < widest * M) wrappedCount.assign(widest * M, static_cast<double>(offsets.size()));
+        }
+        std::atomic<int> badRows{0};
+        auto wrap = [](int v, int n) { return ((v % n) + n) % n; };
+        auto sweepTile = [&](size_t t) {
+            const tile& tl = tiles[t];
+            const int r0 = tl.i0 - H;
+            const int c0 = tl.j0 - H;
+            const int lRows = tl.i1 - tl.i0 + 2 * H;
+            const int lCols = tl.j1 - tl.j0 + 2 * H;
+            const size_t plane = static_cast<size_t>(lRows) * lCols * M;
+
+            thread_local std::vector<double> scratch;
+            thread_local std::vector<long> localOffsets;
+            if (scratch.size() < 4 * plane) scratch.resize(4 * plane);
+            double* ls[2] = {scratch.data(), scratch.data() + 2 * plane};
+            double* lb[2] = {scratch.data() + plane, scratch.data() + 3 * plane};
+            localOffsets.clear();
+            for (const auto& [di, dj] : relOffsets) {
+                localOffsets.push_back((static_cast<long>(di) * lCols + dj) * static_cast<long>(M));
+            }
+            auto local = [&](int gi, int gj) {
+                return (static_cast<size_t>(gi - r0) * lCols + (gj - c0)) * M;
+            };
+            // Only the pass's last step is counted, so a row is reported once whatever k is,
+            // as step() reports it after its final step
+            auto run = [&](const vegetationRow& row, bool last) {
+                if (!kernel.kernel(row, lanes) && last) {
+                    badRows.fetch_add(1, std::memory_order_relaxed);
+                }
+            };
+
+            // Scratch cells outside a non-wrapped grid are read as zero-valued neighbors, never updated
+            if (!wrapped) {
+                for (int li = 0; li < lRows; ++li) {
+                    const int gi = r0 + li;
+                    const size_t rowStart = static_cast<size_t>(li) * lCols * M;
+                    const bool outside = gi < 0 || gi >= nRows;
+                    const size_t left = outside ? lCols * M : std::clamp(-c0, 0, lCols) * M;
+                    const size_t right = outside ? 0 : std::clamp(c0 + lCols - nCols, 0, lCols) * M;
+                    for (double* p : {ls[0], lb[0], ls[1], lb[1]}) {
+                        std::fill_n(p + rowStart, left, 0.0);
+                        std::fill_n(p + rowStart + lCols * M - right, right, 0.0);
+                    }
+                }
+            }
+
+            for (int st = 0; st < k; ++st) {
+                const int e = (k - 1 - st) * halo;
+                int ra = tl.i0 - e, rb = tl.i1 + e, ca = tl.j0 - e, cb = tl.j1 + e;
+                if (!wrapped) {
+                    ra = std::max(ra, 0); rb = std::min(rb, nRows);
+                    ca = std::max(ca, 0); cb = std::min(cb, nCols);
+                }
+                const int in = (st + 1) % 2;    // buffer written by the previous step
+                for (int gi = ra; gi < rb; ++gi) {
+                    const double* rowCount = wrapped ? wrappedCount.data()
+                                                     : count.data() + (static_cast<size_t>(gi) * nCols + ca) * M;
+                    if (st == 0) {
+                        // Current planes -> scratch; a wrapped row is split where it wraps
+                        const int wi = wrap(gi, nRows);
+                        for (int ja = ca; ja < cb;) {
+                            const int wj = wrap(ja, nCols);
+                            const int jb = std::min(cb, ja + nCols - wj);
+                            const size_t g = element(wi, wj, 0);
+                            const size_t c = local(gi, ja);
+                            run({S[cur].data() + g, B[cur].data() + g, rowCount, ls[0] + c, lb[0] + c,
+                                 offsets.data(), offsets.size(), (jb - ja) * static_cast<int>(M)}, k == 1);
+                            ja = jb;
+                        }
+                    } else if (st == k - 1) {
+                        // Scratch -> next planes; the last step covers exactly the tile interior
+                        const size_t c = local(gi, ca);
+                        const size_t g = element(gi, ca, 0);
+                        run({ls[in] + c, lb[in] + c, rowCount, S[1 - cur].data() + g, B[1 - cur].data() + g,
+                             localOffsets.data(), localOffsets.size(), (cb - ca) * static_cast<int>(M)}, true);
+                    } else {
+                        const size_t c = local(gi, ca);
+                        run({ls[in] + c, lb[in] + c, rowCount, ls[1 - in] + c, lb[1 - in] + c,
+                             localOffsets.data(), localOffsets.size(), (cb - ca) * static_cast<int>(M)}, false);
+                    }
+                }
+            }
+        };
+        if (pool) {
+            pool->run(tiles.size(), sweepTile);
+        } else {
+            for (size_t t = 0; t < tiles.size(); ++t) sweepTile(t);
+        }
+        cur = 1 - cur;
+        if (badRows.load() > 0) {
+            std::cerr << "  >>> non-finite state in " << badRows.load() << " tile row(s)\n";
+        }
+    }
+
+    /**
+     * @brief Halo exchange for the current planes.
+     * Tiles share the padded planes, so neighbouring tiles read each other's edge
+     * cells directly from the read-only current buffer; only the outer halo needs
+     * refreshing, with wrapped copies (non-wrapped grids keep it at zero).
+     */
+    void exchangeHalo() {
+        if (!wrapped || halo == 0) return;
+        auto wrap = [](int v, int n) { return ((v % n) + n) % n; };
+        for (int k : {0, 1}) {
+            auto& plane = (k == 0) ? S[cur] : B[cur];
+            for (int i = -halo; i < nRows + halo; ++i) {
+                const bool haloRow = i < 0 || i >= nRows;
+                for (int j = -halo; j < nCols + halo; ++j) {
+                    if (!haloRow && j == 0) j = nCols;  // skip the interior span
+                    std::copy_n(plane.data() + element(wrap(i, nRows), wrap(j, nCols), 0), nMembers,
+                                plane.data() + element(i, j, 0));
+                }
+            }
+        }
+    }
+};
+
+#endif // CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_DENSE_HPP_
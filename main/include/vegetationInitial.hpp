@@ -0,0 +1,176 @@
+// include/vegetationInitial.hpp
+#ifndef CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_INITIAL_HPP_
+#define CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_INITIAL_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "vegetationState.hpp"
+
+/*
+ * Compact initial conditions for the dense engine, listed under "scenario.initial"
+ * (one layer or an array of layers, applied in order over cells.default.state and
+ * before any cell_map entry). Paths are relative to the scenario file:
+ *
+ *   {"format": "npy", "S": "soil.npy", "B": "biomass.npy"}          2D C-order <f8 or <f4 arrays
+ *   {"format": "raw", "dtype": "f32", "B": "biomass.f32"}           row-major little-endian values
+ *   {"format": "rle", "runs": [40, 3, 98, 3], "state": {...}}       alternating off/on run lengths
+ *   {"format": "rle", "file": "mask.rle", "state": {...}}           same runs as whitespace-separated text
+ *   {"format": "random", "seed": 7, "fraction": 0.1, "state": {...}}
+ *
+ * Array layers may give S, B or both. Every reader streams one row at a time into
+ * the row-major state vector, so loading allocates O(cols) regardless of grid size.
+ */
+
+//! Element type and shape of a .npy file, positioned at the first value
+struct npyInfo {
+    uint32_t dtype = 8;     //!< bytes per value: 4 (float) or 8 (double)
+    std::vector<size_t> shape;
+};
+
+//! Parse a NumPy .npy header (format 1.0-3.0, little-endian float64/float32, C order)
+inline npyInfo readNpyHeader(std::istream& in, const std::string& path) {
+    char magic[8];
+    in.read(magic, sizeof(magic));
+    if (!in || std::memcmp(magic, "\x93NUMPY", 6) != 0) {
+        throw std::runtime_error("initial condition: " + path + " is not a .npy file");
+    }
+    uint32_t headerLength = 0;
+    if (magic[6] == 1) {
+        uint16_t n = 0;
+        in.read(reinterpret_cast<char*>(&n), sizeof(n));
+        headerLength = n;
+    } else {
+        in.read(reinterpret_cast<char*>(&headerLength), sizeof(headerLength));
+    }
+    std::string header(headerLength, '\0');
+    in.read(header.data(), headerLength);
+    if (!in) throw std::runtime_error("initial condition: truncated header in " + path);
+
+    auto valueOf = [&](const std::string& key) {
+        const auto k = header.find("'" + key + "'");
+        if (k == std::string::npos) throw std::runtime_error("initial condition: no " + key + " in " + path);
+        return header.find(':', k) + 1;
+    };
+    npyInfo info;
+    const size_t descr = header.find('\'', valueOf("descr")) + 1;
+    const std::string type = header.substr(descr, header.find('\'', descr) - descr);
+    if (type == "<f8" || type == "=f8") info.dtype = 8;
+    else if (type == "<f4" || type == "=f4") info.dtype = 4;
+    else throw std::runtime_error("initial condition: unsupported dtype " + type + " in " + path);
+    if (header.compare(header.find_first_not_of(' ', valueOf("fortran_order")), 5, "False") != 0) {
+        throw std::runtime_error("initial condition: " + path + " must be C order");
+    }
+    const size_t open = header.find('(', valueOf("shape"));
+    const size_t close = header.find(')', open);
+    const char* p = header.c_str() + open + 1;
+    while (p < header.c_str() + close) {
+        char* end;
+        const unsigned long long extent = std::strtoull(p, &end, 10);
+        if (end == p) { ++p; continue; }
+        info.shape.push_back(static_cast<size_t>(extent));
+        p = end;
+    }
+    return info;
+}
+
+//! Write a 2D row-major float64 array as .npy (format 1.0), e.g. to convert an initial state
+inline void writeNpy(const std::string& path, const double* values, size_t rows, size_t cols) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) throw std::runtime_error("initial condition: cannot open " + path);
+    std::string header = "{'descr': '<f8', 'fortran_order': False, 'shape': (" +
+                         std::to_string(rows) + ", " + std::to_string(cols) + "), }";
+    header.append(63 - (10 + header.size()) % 64, ' ').push_back('\n');  // pad to 64 bytes
+    const auto headerLength = static_cast<uint16_t>(header.size());
+    out.write("\x93NUMPY\x01\x00", 8);
+    out.write(reinterpret_cast<const char*>(&headerLength), sizeof(headerLength));
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    out.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(rows * cols * sizeof(double)));
+    if (!out) throw std::runtime_error("initial condition: write failed for " + path);
+}
+
+/**
+ * @brief Stream one plane of rows * cols values into S or B of the state vector.
+ * @param field pointer to member selecting vegetationState::S or ::B.
+ */
+inline void readInitialPlane(std::istream& in, uint32_t dtype, int rows, int cols,
+                             double vegetationState::*field, std::vector<vegetationState>& initial,
+                             const std::string& path) {
+    std::vector<char> row(static_cast<size_t>(cols) * dtype);
+    for (int i = 0; i < rows; ++i) {
+        in.read(row.data(), static_cast<std::streamsize>(row.size()));
+        if (!in) throw std::runtime_error("initial condition: " + path + " is smaller than the grid");
+        vegetationState* out = initial.data() + static_cast<size_t>(i) * cols;
+        for (int j = 0; j < cols; ++j) {
+            if (dtype == 4) {
+                float v;
+                std::memcpy(&v, row.data() + static_cast<size_t>(j) * 4, 4);
+                out[j].*field = v;
+            } else {
+                std::memcpy(&(out[j].*field), row.data() + static_cast<size_t>(j) * 8, 8);
+            }
+        }
+    }
+}
+
+//! Apply one "scenario.initial" layer to the row-major state vector
+inline void applyInitialLayer(const nlohmann::json& layer, const std::filesystem::path& baseDir,
+                              int rows, int cols, std::vector<vegetationState>& initial) {
+    const std::string format = layer.at("format").get<std::string>();
+    const size_t cells = static_cast<size_t>(rows) * cols;
+
+    if (format == "npy" || format == "raw") {
+        for (const auto& [key, field] : {std::pair{"S", &vegetationState::S}, std::pair{"B", &vegetationState::B}}) {
+            if (!layer.contains(key)) continue;
+            const std::string path = (baseDir / layer.at(key).get<std::string>()).string();
+            std::ifstream in(path, std::ios::binary);
+            if (!in.is_open()) throw std::runtime_error("initial condition: cannot open " + path);
+            uint32_t dtype = (layer.value("dtype", std::string("f64")) == "f32") ? 4 : 8;
+            if (format == "npy") {
+                const npyInfo info = readNpyHeader(in, path);
+                if (info.shape.size() != 2 || info.shape[0] != static_cast<size_t>(rows) ||
+                    info.shape[1] != static_cast<size_t>(cols)) {
+                    throw std::runtime_error("initial condition: " + path + " does not match the scenario shape");
+                }
+                dtype = info.dtype;
+            }
+            readInitialPlane(in, dtype, rows, cols, field, initial, path);
+        }
+    } else if (format == "rle") {
+        const vegetationState state = layer.at("state").get<vegetationState>();
+        size_t cell = 0;
+        bool on = false;
+        auto run = [&](unsigned long long length) {
+            if (length > cells - cell) throw std::out_of_range("initial condition: run-length mask exceeds the grid");
+            if (on) std::fill_n(initial.data() + cell, length, state);
+            cell += length;
+            on = !on;
+        };
+        if (layer.contains("runs")) {
+            for (const auto& length : layer.at("runs")) run(length.get<unsigned long long>());
+        } else {
+            const std::string path = (baseDir / layer.at("file").get<std::string>()).string();
+            std::ifstream in(path);
+            if (!in.is_open()) throw std::runtime_error("initial condition: cannot open " + path);
+            unsigned long long length;
+            while (in >> length) run(length);
+        }
+    } else if (format == "random") {
+        // Counter-based: each cell's draw depends only on (seed, cell index)
+        const vegetationState state = layer.at("state").get<vegetationState>();
+        const uint64_t seed = layer.value("seed", uint64_t{0});
+        const double fraction = layer.value("fraction", 0.1);
+        for (size_t k = 0; k < cells; ++k) {
+            if (static_cast<double>(vegetationHash(seed, k) >> 11) * 0x1.0p-53 < fraction) initial[k] = state;
+        }
+    } else {
+        throw std::invalid_argument("initial condition: unsupported format \"" + format + "\"");
+    }
+}
+
+#endif // CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_INITIAL_HPP_
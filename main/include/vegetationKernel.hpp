@@ -0,0 +1,297 @@
+// include/vegetationKernel.hpp
+#ifndef CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_KERNEL_HPP_
+#define CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_KERNEL_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "vegetationParams.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VEGETATION_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+//! One row of the dense sweep: pointers address the first element of the row in the padded planes
+struct vegetationRow {
+    const double* S;        //!< current soil moisture
+    const double* B;        //!< current biomass
+    const double* count;    //!< in-grid neighbor count per cell
+    double* SNext;          //!< next soil moisture
+    double* BNext;          //!< next biomass
+    const long* offsets;    //!< neighbor offsets in padded-plane elements
+    size_t nOffsets;
+    int width;              //!< number of elements (cells x ensemble members) in the row
+};
+
+/**
+ * @brief Model parameters of the ensemble members interleaved in a row.
+ * Element j of a row belongs to member j % size(). The table expands the members
+ * so that the parameters of any run of up to maxLanes consecutive elements are one
+ * vector load: at(phase, f)[lane] is field f of member (phase + lane) % size().
+ * A plain run is the one-member case.
+ */
+struct vegetationLanes {
+    enum field { Gamma, Sigma, Mu, Pho, Delta, P, Beta, Dt, DX2, nFields };
+    static constexpr size_t maxLanes = 8;
+
+    std::vector<vegetationParams> members;
+    std::vector<double> table;
+
+    explicit vegetationLanes(std::vector<vegetationParams> params = {vegetationParams{}})
+        : members(std::move(params)) {
+        if (members.empty()) members.emplace_back();
+        table.resize(members.size() * nFields * maxLanes);
+        for (size_t phase = 0; phase < members.size(); ++phase) {
+            for (size_t lane = 0; lane < maxLanes; ++lane) {
+                const vegetationParams& prm = members[(phase + lane) % members.size()];
+                const double values[nFields] = {prm.gamma, prm.sigma, prm.mu, prm.pho, prm.delta,
+                                                prm.p, prm.beta, prm.dt, prm.dX2};
+                for (int f = 0; f < nFields; ++f) {
+                    table[(phase * nFields + f) * maxLanes + lane] = values[f];
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] size_t size() const { return members.size(); }
+    [[nodiscard]] const double* at(size_t phase, field f) const {
+        return table.data() + (phase * nFields + f) * maxLanes;
+    }
+};
+
+/**
+ * @brief Row kernel signature.
+ * @return false if any updated S or B in the row is not finite (one reduction per row).
+ */
+using vegetationRowKernel = bool (*)(const vegetationRow&, const vegetationLanes&);
+
+//! Scalar update of element j, the reference for every vectorized variant
+inline void vegetationCellUpdate(const vegetationRow& row, const vegetationParams& prm, int j) {
+    double sumSb = 0.0;
+    double sumB  = 0.0;
+    for (size_t k = 0; k < row.nOffsets; ++k) {
+        const long o = j + row.offsets[k];
+        sumSb += (row.S[o] - prm.beta * row.B[o]);
+        sumB  += row.B[o];
+    }
+    vegetationEuler(row.S[j], row.B[j], sumSb, sumB, row.count[j], prm, row.SNext[j], row.BNext[j]);
+}
+
+//! Scalar tail shared by all kernels; x - x is non-zero only for Inf/NaN
+inline bool vegetationRowScalarRange(const vegetationRow& row, const vegetationLanes& lanes, int begin) {
+    double bad = 0.0;
+    size_t member = static_cast<size_t>(begin) % lanes.size();
+    for (int j = begin; j < row.width; ++j) {
+        vegetationCellUpdate(row, lanes.members[member], j);
+        bad += (row.SNext[j] - row.SNext[j]) + (row.BNext[j] - row.BNext[j]);
+        if (++member == lanes.size()) member = 0;
+    }
+    return bad == 0.0;
+}
+
+inline bool vegetationRowScalar(const vegetationRow& row, const vegetationLanes& lanes) {
+    return vegetationRowScalarRange(row, lanes, 0);
+}
+
+#ifdef VEGETATION_KERNEL_X86
+__attribute__((target("avx2")))
+inline bool vegetationRowAVX2(const vegetationRow& row, const vegetationLanes& lanes) {
+    const size_t members = lanes.size();
+    const size_t phaseStep = 4 % members;
+    size_t phase = 0;
+    const __m256d one   = _mm256_set1_pd(1.0);
+    const __m256d zero  = _mm256_setzero_pd();
+    __m256d bad = zero;
+
+    int j = 0;
+    for (; j + 4 <= row.width; j += 4) {
+        // Parameters of the members in these lanes, one L1-resident load each
+        const __m256d beta  = _mm256_loadu_pd(lanes.at(phase, vegetationLanes::Beta));
+        const __m256d dX2   = _mm256_loadu_pd(lanes.at(phase, vegetationLanes::DX2));
+        const __m256d p     = _mm256_loadu_pd(lanes.at(phase, vegetationLanes::P));
+        const __m256d pho   = _mm256_loadu_pd(lanes.at(phase, vegetationLanes::Pho));
+        const __m256d delta = _mm256_loadu_pd(lanes.at(phase, vegetationLanes::Delta));
+        const __m256d gamma = _mm256_loadu_pd(lanes.at(phase, vegetationLanes::Gamma));
+        const __m256d sigma = _mm256_loadu_pd(lanes.at(phase, vegetationLanes::Sigma));
+        const __m256d mu    = _mm256_loadu_pd(lanes.at(phase, vegetationLanes::Mu));
+        const __m256d dt    = _mm256_loadu_pd(lanes.at(phase, vegetationLanes::Dt));
+        __m256d lapSb = zero;
+        __m256d lapB  = zero;
+        for (size_t k = 0; k < row.nOffsets; ++k) {
+            const long o = j + row.offsets[k];
+            const __m256d s = _mm256_loadu_pd(row.S + o);
+            const __m256d b = _mm256_loadu_pd(row.B + o);
+            lapSb = _mm256_add_pd(lapSb, _mm256_sub_pd(s, _mm256_mul_pd(beta, b)));
+            lapB  = _mm256_add_pd(lapB, b);
+        }
+        const __m256d S0 = _mm256_loadu_pd(row.S + j);
+        const __m256d B0 = _mm256_loadu_pd(row.B + j);
+        const __m256d N  = _mm256_loadu_pd(row.count + j);
+        const __m256d sb0 = _mm256_sub_pd(S0, _mm256_mul_pd(beta, B0));
+        lapSb = _mm256_div_pd(_mm256_sub_pd(lapSb, _mm256_mul_pd(N, sb0)), dX2);
+        lapB  = _mm256_div_pd(_mm256_sub_pd(lapB, _mm256_mul_pd(N, B0)), dX2);
+
+        __m256d dSdt = _mm256_sub_pd(p, _mm256_mul_pd(_mm256_sub_pd(one, _mm256_mul_pd(pho, B0)), S0));
+        dSdt = _mm256_sub_pd(dSdt, _mm256_mul_pd(_mm256_mul_pd(S0, S0), B0));
+        dSdt = _mm256_add_pd(dSdt, _mm256_mul_pd(delta, lapSb));
+        const __m256d growth = _mm256_div_pd(_mm256_mul_pd(gamma, S0),
+                                             _mm256_add_pd(one, _mm256_mul_pd(sigma, S0)));
+        __m256d dBdt = _mm256_sub_pd(_mm256_mul_pd(growth, B0), _mm256_mul_pd(B0, B0));
+        dBdt = _mm256_sub_pd(dBdt, _mm256_mul_pd(mu, B0));
+        dBdt = _mm256_add_pd(dBdt, lapB);
+
+        const __m256d S1 = _mm256_add_pd(S0, _mm256_mul_pd(dSdt, dt));
+        const __m256d B1 = _mm256_add_pd(B0, _mm256_mul_pd(dBdt, dt));
+        _mm256_storeu_pd(row.SNext + j, S1);
+        _mm256_storeu_pd(row.BNext + j, B1);
+        bad = _mm256_or_pd(bad, _mm256_cmp_pd(_mm256_sub_pd(S1, S1), zero, _CMP_NEQ_UQ));
+        bad = _mm256_or_pd(bad, _mm256_cmp_pd(_mm256_sub_pd(B1, B1), zero, _CMP_NEQ_UQ));
+        phase += phaseStep;
+        if (phase >= members) phase -= members;
+    }
+    const bool finite = vegetationRowScalarRange(row, lanes, j);
+    return finite && _mm256_movemask_pd(bad) == 0;
+}
+
+__attribute__((target("avx512f")))
+inline bool vegetationRowAVX512(const vegetationRow& row, const vegetationLanes& lanes) {
+    const size_t members = lanes.size();
+    const size_t phaseStep = 8 % members;
+    size_t phase = 0;
+    const __m512d one   = _mm512_set1_pd(1.0);
+    const __m512d zero  = _mm512_setzero_pd();
+    __mmask8 bad = 0;
+
+    int j = 0;
+    for (; j + 8 <= row.width; j += 8) {
+        // Parameters of the members in these lanes, one L1-resident load each
+        const __m512d beta  = _mm512_loadu_pd(lanes.at(phase, vegetationLanes::Beta));
+        const __m512d dX2   = _mm512_loadu_pd(lanes.at(phase, vegetationLanes::DX2));
+        const __m512d p     = _mm512_loadu_pd(lanes.at(phase, vegetationLanes::P));
+        const __m512d pho   = _mm512_loadu_pd(lanes.at(phase, vegetationLanes::Pho));
+        const __m512d delta = _mm512_loadu_pd(lanes.at(phase, vegetationLanes::Delta));
+        const __m512d gamma = _mm512_loadu_pd(lanes.at(phase, vegetationLanes::Gamma));
+        const __m512d sigma = _mm512_loadu_pd(lanes.at(phase, vegetationLanes::Sigma));
+        const __m512d mu    = _mm512_loadu_pd(lanes.at(phase, vegetationLanes::Mu));
+        const __m512d dt    = _mm512_loadu_pd(lanes.at(phase, vegetationLanes::Dt));
+        __m512d lapSb = zero;
+        __m512d lapB  = zero;
+        for (size_t k = 0; k < row.nOffsets; ++k) {
+            const long o = j + row.offsets[k];
+            const __m512d s = _mm512_loadu_pd(row.S + o);
+            const __m512d b = _mm512_loadu_pd(row.B + o);
+            lapSb = _mm512_add_pd(lapSb, _mm512_sub_pd(s, _mm512_mul_pd(beta, b)));
+            lapB  = _mm512_add_pd(lapB, b);
+        }
+        const __m512d S0 = _mm512_loadu_pd(row.S + j);
+        const __m512d B0 = _mm512_loadu_pd(row.B + j);
+        const __m512d N  = _mm512_loadu_pd(row.count + j);
+        const __m512d sb0 = _mm512_sub_pd(S0, _mm512_mul_pd(beta, B0));
+        lapSb = _mm512_div_pd(_mm512_sub_pd(lapSb, _mm512_mul_pd(N, sb0)), dX2);
+        lapB  = _mm512_div_pd(_mm512_sub_pd(lapB, _mm512_mul_pd(N, B0)), dX2);
+
+        __m512d dSdt = _mm512_sub_pd(p, _mm512_mul_pd(_mm512_sub_pd(one, _mm512_mul_pd(pho, B0)), S0));
+        dSdt = _mm512_sub_pd(dSdt, _mm512_mul_pd(_mm512_mul_pd(S0, S0), B0));
+        dSdt = _mm512_add_pd(dSdt, _mm512_mul_pd(delta, lapSb));
+        const __m512d growth = _mm512_div_pd(_mm512_mul_pd(gamma, S0),
+                                             _mm512_add_pd(one, _mm512_mul_pd(sigma, S0)));
+        __m512d dBdt = _mm512_sub_pd(_mm512_mul_pd(growth, B0), _mm512_mul_pd(B0, B0));
+        dBdt = _mm512_sub_pd(dBdt, _mm512_mul_pd(mu, B0));
+        dBdt = _mm512_add_pd(dBdt, lapB);
+
+        const __m512d S1 = _mm512_add_pd(S0, _mm512_mul_pd(dSdt, dt));
+        const __m512d B1 = _mm512_add_pd(B0, _mm512_mul_pd(dBdt, dt));
+        _mm512_storeu_pd(row.SNext + j, S1);
+        _mm512_storeu_pd(row.BNext + j, B1);
+        bad |= _mm512_cmp_pd_mask(_mm512_sub_pd(S1, S1), zero, _CMP_NEQ_UQ);
+        bad |= _mm512_cmp_pd_mask(_mm512_sub_pd(B1, B1), zero, _CMP_NEQ_UQ);
+        phase += phaseStep;
+        if (phase >= members) phase -= members;
+    }
+    const bool finite = vegetationRowScalarRange(row, lanes, j);
+    return finite && bad == 0;
+}
+#endif // VEGETATION_KERNEL_X86
+
+//! A selectable kernel variant
+struct vegetationKernelInfo {
+    std::string name;
+    vegetationRowKernel kernel;
+};
+
+//! Kernels usable on this CPU, widest first; "scalar" is always last
+inline std::vector<vegetationKernelInfo> availableRowKernels() {
+    std::vector<vegetationKernelInfo> kernels;
+#ifdef VEGETATION_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) kernels.push_back({"avx512", vegetationRowAVX512});
+    if (__builtin_cpu_supports("avx2"))    kernels.push_back({"avx2", vegetationRowAVX2});
+#endif
+    kernels.push_back({"scalar", vegetationRowScalar});
+    return kernels;
+}
+
+/**
+ * @brief Golden-output check of a kernel against the scalar formula.
+ * Runs both on a deterministic 5-point row (37 elements, so every vector tail is hit)
+ * with the default parameters and with three interleaved members whose parameters
+ * differ. Every updated value must be identical (a NaN never is); the full check
+ * against vegetationCell::localComputation is the kernel-golden test.
+ */
+inline bool checkRowKernel(vegetationRowKernel kernel) {
+    const int width = 37;
+    const int pitch = width + 2;
+    std::vector<double> S(3 * pitch), B(3 * pitch), count(width, 5.0);
+    for (size_t k = 0; k < S.size(); ++k) {
+        S[k] = 0.5 + 0.37 * std::sin(0.7 * static_cast<double>(k));
+        B[k] = (k % 3 == 0) ? 2.0 : 0.25 * std::cos(1.3 * static_cast<double>(k)) + 0.25;
+    }
+    const long offsets[] = {-pitch, -1, 0, 1, pitch};
+    std::vector<double> sRef(width), bRef(width), sOut(width), bOut(width);
+    vegetationRow ref{S.data() + pitch + 1, B.data() + pitch + 1, count.data(),
+                      sRef.data(), bRef.data(), offsets, 5, width};
+    vegetationRow out = ref;
+    out.SNext = sOut.data();
+    out.BNext = bOut.data();
+
+    vegetationParams wet, dry;
+    wet.p = 0.3;
+    wet.gamma = 1.4;
+    dry.p = 0.1;
+    dry.beta = 2.5;
+    for (const vegetationLanes& lanes : {vegetationLanes{}, vegetationLanes({vegetationParams{}, wet, dry})}) {
+        vegetationRowScalar(ref, lanes);
+        if (!kernel(out, lanes)) return false;
+        for (int j = 0; j < width; ++j) {
+            if (!(sOut[j] == sRef[j] && bOut[j] == bRef[j])) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Pick the row kernel at startup.
+ * @param requested "auto" for the widest supported ISA, or a kernel name.
+ * @throws std::runtime_error if the chosen variant fails checkRowKernel(): its output
+ * would silently diverge from the Cadmium model, so the run does not start.
+ */
+inline vegetationKernelInfo selectRowKernel(const std::string& requested = "auto") {
+    for (const auto& info : availableRowKernels()) {
+        if (requested != "auto" && requested != info.name) continue;
+        if (!checkRowKernel(info.kernel)) {
+            throw std::runtime_error("row kernel '" + info.name + "' does not match the scalar update");
+        }
+        return info;
+    }
+    if (requested != "auto" && requested != "scalar") {
+        std::cerr << "Row kernel '" << requested << "' unavailable, using scalar\n";
+    }
+    return {"scalar", vegetationRowScalar};
+}
+
+#endif // CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_KERNEL_HPP_
@@ -0,0 +1,70 @@
+// include/vegetationParams.hpp
+#ifndef CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_PARAMS_HPP_
+#define CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_PARAMS_HPP_
+
+#include <nlohmann/json.hpp>
+
+//! Rietkerk/Hardenberg model parameters shared by the Cadmium cell and the dense engine
+struct vegetationParams {
+    double gamma = 1.6;
+    double sigma = 1.6;
+    double mu    = 0.2;
+    double pho   = 1.5;
+    double delta = 100.0;
+    double p     = 0.15;
+    double beta  = 3.0;
+    double dt    = 0.0005;  // Cadmium time-step
+    // Physical grid spacing: length=128 over n=256 cells => dx=0.5
+    double dX2   = 0.5 * 0.5;
+};
+
+//! Parse a "parameters" object; absent keys keep their current value, so it also patches a parameter set
+inline void from_json(const nlohmann::json& j, vegetationParams& prm) {
+    prm.gamma = j.value("gamma", prm.gamma);
+    prm.sigma = j.value("sigma", prm.sigma);
+    prm.mu    = j.value("mu", prm.mu);
+    prm.pho   = j.value("pho", prm.pho);
+    prm.delta = j.value("delta", prm.delta);
+    prm.p     = j.value("p", prm.p);
+    prm.beta  = j.value("beta", prm.beta);
+    prm.dt    = j.value("dt", prm.dt);
+    prm.dX2   = j.value("dX2", prm.dX2);
+}
+
+//! Parameters of one cell configuration (its optional "parameters" object over the defaults)
+inline vegetationParams vegetationParamsFromConfig(const nlohmann::json& cellConfig) {
+    vegetationParams prm;
+    if (cellConfig.contains("parameters")) {
+        from_json(cellConfig.at("parameters"), prm);
+    }
+    return prm;
+}
+
+/**
+ * @brief One explicit Euler step of the Rietkerk model for one cell.
+ * This is the update of vegetationCell::localComputation and of every dense row
+ * kernel; callers only differ in how they gather the neighbor sums.
+ * @param sumSb sum of S - beta * B over the neighborhood (including the cell itself).
+ * @param sumB sum of B over the neighborhood.
+ * @param n number of neighbors in the sums.
+ */
+inline void vegetationEuler(double S0, double B0, double sumSb, double sumB, double n,
+                            const vegetationParams& prm, double& S1, double& B1) {
+    const double sb0 = S0 - prm.beta * B0;
+    const double lap_Sb = (sumSb - n * sb0) / prm.dX2;
+    const double lap_B  = (sumB  - n * B0)  / prm.dX2;
+
+    // Reaction-diffusion equations
+    const double dSdt = prm.p
+        - (1.0 - prm.pho * B0) * S0
+        - S0 * S0 * B0
+        + prm.delta * lap_Sb;
+    const double dBdt = (prm.gamma * S0 / (1.0 + prm.sigma * S0)) * B0
+        - B0 * B0
+        - prm.mu * B0
+        + lap_B;
+    S1 = S0 + dSdt * prm.dt;
+    B1 = B0 + dBdt * prm.dt;
+}
+
+#endif // CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_PARAMS_HPP_
@@ -0,0 +1,121 @@
+// include/vegetationProfile.hpp
+#ifndef CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_PROFILE_HPP_
+#define CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_PROFILE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+//! Phases timed by profileScope; each is one row of profileReport()
+enum class profilePhase {
+    modelBuild,         //!< model / neighbor map construction (GridCellDEVSCoupled, vegetationDense setup)
+    localComputation,   //!< vegetationCell::localComputation
+    routing,            //!< Cadmium simulate() minus the local computations and logger calls in it
+    halo,               //!< dense halo exchange
+    sweep,              //!< dense row kernels (including temporal-block copies)
+    logFormat,          //!< simulation-thread logging: collecting records or copying frames
+    logWrite,           //!< writer-thread logging: CSV formatting and file output
+    checkpoint,         //!< checkpoint copy and write
+    count
+};
+
+inline const char* profilePhaseName(profilePhase phase) {
+    static const char* const names[] = {"model build", "localComputation", "routing", "halo exchange",
+                                        "sweep", "log format", "log write", "checkpoint"};
+    return names[static_cast<int>(phase)];
+}
+
+//! Global switch (--profile); when false a profileScope costs one load and branch
+inline bool profilingEnabled = false;
+
+struct profileCounter {
+    std::atomic<uint64_t> ns{0};
+    std::atomic<uint64_t> calls{0};
+};
+
+inline profileCounter profileCounters[static_cast<int>(profilePhase::count)];
+
+inline void profileAdd(profilePhase phase, uint64_t ns) {
+    auto& counter = profileCounters[static_cast<int>(phase)];
+    counter.ns.fetch_add(ns, std::memory_order_relaxed);
+    counter.calls.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline uint64_t profileNanoseconds(profilePhase phase) {
+    return profileCounters[static_cast<int>(phase)].ns.load(std::memory_order_relaxed);
+}
+
+inline void profileReset() {
+    for (auto& counter : profileCounters) {
+        counter.ns.store(0, std::memory_order_relaxed);
+        counter.calls.store(0, std::memory_order_relaxed);
+    }
+}
+
+//! Adds the lifetime of the scope to a phase while profiling is enabled
+class profileScope {
+public:
+    explicit profileScope(profilePhase phase) : phase(phase), active(profilingEnabled) {
+        if (active) started = std::chrono::steady_clock::now();
+    }
+
+    ~profileScope() {
+        if (active) {
+            const auto elapsed = std::chrono::steady_clock::now() - started;
+            profileAdd(phase, static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+    }
+
+    profileScope(const profileScope&) = delete;
+    profileScope& operator=(const profileScope&) = delete;
+
+private:
+    profilePhase phase;
+    bool active;
+    std::chrono::steady_clock::time_point started;
+};
+
+//! Process high-water mark of resident memory (getrusage reports KiB on Linux; the peak working set on Windows)
+inline double peakRSSMiB() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0.0;
+    return static_cast<double>(counters.PeakWorkingSetSize) / (1024.0 * 1024.0);
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;
+#endif
+}
+
+//! Table of every phase that ran: calls, total time and ns per cell-update
+inline void profileReport(std::ostream& os, double cellUpdates) {
+    const auto precision = os.precision();
+    os << "Profile (" << std::scientific << std::setprecision(3) << cellUpdates << " cell-updates):\n"
+       << "  phase                     calls       total ms   ns/cell-update\n";
+    for (int p = 0; p < static_cast<int>(profilePhase::count); ++p) {
+        const auto& counter = profileCounters[p];
+        const uint64_t ns = counter.ns.load(std::memory_order_relaxed);
+        if (counter.calls.load(std::memory_order_relaxed) == 0) continue;
+        os << "  " << std::left << std::setw(20) << profilePhaseName(static_cast<profilePhase>(p)) << std::right
+           << std::setw(12) << counter.calls.load(std::memory_order_relaxed)
+           << std::fixed << std::setprecision(2) << std::setw(15) << static_cast<double>(ns) / 1e6
+           << std::setw(17) << (cellUpdates > 0.0 ? static_cast<double>(ns) / cellUpdates : 0.0) << "\n";
+    }
+    os << std::defaultfloat << std::setprecision(precision);
+    os.flush();
+}
+
+#endif // CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_PROFILE_HPP_
@@ -0,0 +1,44 @@
+// include/vegetationRun.hpp
+#ifndef CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_RUN_HPP_
+#define CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_RUN_HPP_
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+#include "vegetationCell.hpp"
+#include "vegetationDense.hpp"
+
+// Helpers shared by the simulator and gray-scott-bench
+
+//! Factory: create vegetation cells
+inline std::shared_ptr<GridCell<vegetationState, double>> addGridCell(
+    const std::vector<int>& cellId,
+    const std::shared_ptr<const GridCellConfig<vegetationState, double>>& cellConfig) {
+    if (cellConfig->cellModel == "vegetation") {
+        return std::make_shared<vegetationCell>(cellId, cellConfig);
+    } else {
+        throw std::bad_typeid();
+    }
+}
+
+inline double secondsSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+//! Grid size "N" or "RxC"
+inline std::pair<int, int> parseSize(const std::string& text) {
+    const auto x = text.find('x');
+    const int rows = std::stoi(text.substr(0, x));
+    return {rows, x == std::string::npos ? rows : std::stoi(text.substr(x + 1))};
+}
+
+//! Cell updates per second over `steps` steps of every ensemble member
+inline double cellUpdatesPerSecond(const vegetationDense& engine, long steps, double seconds) {
+    const double updates = static_cast<double>(engine.cells() * engine.members()) * static_cast<double>(steps);
+    return seconds > 0.0 ? updates / seconds : 0.0;
+}
+
+#endif // CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_RUN_HPP_
@@ -0,0 +1,404 @@
+// include/vegetationSnapshot.hpp
+#ifndef CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_SNAPSHOT_HPP_
+#define CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_SNAPSHOT_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "vegetationState.hpp"
+
+/*
+ * Binary snapshot format (.vsnap), native little-endian:
+ *
+ *   header  char[8] magic "VEGSNAP1"
+ *           uint32  version (1)
+ *           uint32  rows, cols          shape of the stored planes
+ *           uint32  stride              spatial logging cadence: every stride-th row and column
+ *           uint32  gridRows, gridCols  scenario.shape
+ *           uint32  dtype               bytes per value: 4 = float32, 8 = float64
+ *           uint32  codec               0 = raw, 1 = byte-shuffle + LZ
+ *           uint32  nFields             followed by nFields x (uint32 length, chars)
+ *   frame   double  time
+ *           uint64  stored bytes        payload size in the file
+ *           uint64  raw bytes           nFields * rows * cols * dtype
+ *           payload                     field planes back to back, row-major
+ */
+
+enum class snapshotCodec : uint32_t { raw = 0, lz = 1 };
+
+//! Transpose the bytes of n elements of the given width so equal-significance bytes are adjacent
+inline void snapshotShuffle(const uint8_t* src, uint8_t* dst, size_t n, size_t width) {
+    for (size_t e = 0; e < n; ++e) {
+        for (size_t b = 0; b < width; ++b) dst[b * n + e] = src[e * width + b];
+    }
+}
+
+inline void snapshotUnshuffle(const uint8_t* src, uint8_t* dst, size_t n, size_t width) {
+    for (size_t e = 0; e < n; ++e) {
+        for (size_t b = 0; b < width; ++b) dst[e * width + b] = src[b * n + e];
+    }
+}
+
+inline void lzPutLength(std::vector<uint8_t>& out, size_t len) {
+    while (len >= 255) {
+        out.push_back(255);
+        len -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(len));
+}
+
+/**
+ * @brief Greedy LZ77 block compressor using the LZ4 sequence layout.
+ * Each sequence is a token (literal length << 4 | match length - 4), extra length
+ * bytes, the literals, a 16-bit match offset and extra match-length bytes. The
+ * last sequence carries literals only. `table` is caller-owned scratch for the match finder.
+ */
+inline void lzCompress(const uint8_t* src, size_t n, std::vector<uint8_t>& out, std::vector<uint32_t>& table) {
+    constexpr size_t minMatch = 4;
+    constexpr int hashBits = 16;
+    table.assign(size_t{1} << hashBits, UINT32_MAX);
+    auto hash = [&](size_t pos) {
+        uint32_t v;
+        std::memcpy(&v, src + pos, sizeof(v));
+        return (v * 2654435761u) >> (32 - hashBits);
+    };
+    out.clear();
+    size_t anchor = 0;
+    size_t pos = 0;
+    while (pos + minMatch <= n) {
+        const uint32_t h = hash(pos);
+        const uint32_t cand = table[h];
+        table[h] = static_cast<uint32_t>(pos);
+        if (cand == UINT32_MAX || pos - cand > 0xFFFF || std::memcmp(src + cand, src + pos, minMatch) != 0) {
+            ++pos;
+            continue;
+        }
+        size_t len = minMatch;
+        while (pos + len < n && src[cand + len] == src[pos + len]) ++len;
+
+        const size_t literals = pos - anchor;
+        const size_t extra = len - minMatch;
+        out.push_back(static_cast<uint8_t>((std::min<size_t>(literals, 15) << 4) | std::min<size_t>(extra, 15)));
+        if (literals >= 15) lzPutLength(out, literals - 15);
+        out.insert(out.end(), src + anchor, src + pos);
+        const size_t offset = pos - cand;
+        out.push_back(static_cast<uint8_t>(offset & 0xFF));
+        out.push_back(static_cast<uint8_t>(offset >> 8));
+        if (extra >= 15) lzPutLength(out, extra - 15);
+        pos += len;
+        anchor = pos;
+    }
+    const size_t literals = n - anchor;
+    out.push_back(static_cast<uint8_t>(std::min<size_t>(literals, 15) << 4));
+    if (literals >= 15) lzPutLength(out, literals - 15);
+    out.insert(out.end(), src + anchor, src + n);
+}
+
+inline void lzDecompress(const uint8_t* src, size_t n, uint8_t* dst, size_t rawSize) {
+    size_t in = 0;
+    size_t out = 0;
+    auto readLength = [&](size_t len) {
+        if (len != 15) return len;
+        uint8_t b;
+        do {
+            if (in >= n) throw std::runtime_error("snapshot: truncated LZ block");
+            b = src[in++];
+            len += b;
+        } while (b == 255);
+        return len;
+    };
+    while (in < n) {
+        const uint8_t token = src[in++];
+        const size_t literals = readLength(token >> 4);
+        if (in + literals > n || out + literals > rawSize) throw std::runtime_error("snapshot: corrupt LZ block");
+        std::memcpy(dst + out, src + in, literals);
+        in += literals;
+        out += literals;
+        if (in >= n) break;  // last sequence: literals only
+        if (in + 2 > n) throw std::runtime_error("snapshot: truncated LZ block");
+        const size_t offset = src[in] | (static_cast<size_t>(src[in + 1]) << 8);
+        in += 2;
+        const size_t len = readLength(token & 0x0F) + 4;
+        if (offset == 0 || offset > out || out + len > rawSize) throw std::runtime_error("snapshot: corrupt LZ block");
+        for (size_t k = 0; k < len; ++k, ++out) dst[out] = dst[out - offset];  // overlapping copy
+    }
+    if (out != rawSize) throw std::runtime_error("snapshot: LZ block size mismatch");
+}
+
+//! File header
+struct snapshotHeader {
+    uint32_t rows = 0;
+    uint32_t cols = 0;
+    uint32_t stride = 1;
+    uint32_t gridRows = 0;
+    uint32_t gridCols = 0;
+    uint32_t dtype = 8;
+    snapshotCodec compression = snapshotCodec::raw;
+    std::vector<std::string> fields{"S", "B"};
+
+    [[nodiscard]] size_t planeValues() const { return static_cast<size_t>(rows) * cols; }
+    [[nodiscard]] size_t frameBytes() const { return fields.size() * planeValues() * dtype; }
+};
+
+//! Rows or columns kept when logging every stride-th one of n
+inline uint32_t sampledExtent(uint32_t n, uint32_t stride) {
+    return (n + stride - 1) / stride;
+}
+
+//! Column header of the CustomCSVLogger layout read by the DEVS Viewer
+inline void writeCSVHeader(std::ostream& out, const std::string& delimiter) {
+    out << "time" << delimiter
+        << "model_id" << delimiter
+        << "model_name" << delimiter
+        << "port_name" << delimiter
+        << "data" << "\n";
+}
+
+/**
+ * @brief Write sampled S/B planes as CustomCSVLogger state lines.
+ * Cell (i, j) of the planes is grid cell (i*stride, j*stride); model ids are the
+ * row-major index in the full grid, as written by the dense engine.
+ */
+inline void writeSnapshotCSV(std::ostream& out, double t, const double* S, const double* B,
+                             const snapshotHeader& hdr, const std::string& delimiter) {
+    for (uint32_t i = 0; i < hdr.rows; ++i) {
+        for (uint32_t j = 0; j < hdr.cols; ++j) {
+            const size_t k = static_cast<size_t>(i) * hdr.cols + j;
+            const uint64_t gi = static_cast<uint64_t>(i) * hdr.stride;
+            const uint64_t gj = static_cast<uint64_t>(j) * hdr.stride;
+            out << t << delimiter
+                << gi * hdr.gridCols + gj << delimiter
+                << "(" << gi << "," << gj << ")" << delimiter
+                << "" << delimiter
+                << vegetationState(S[k], B[k]) << "\n";
+        }
+    }
+}
+
+//! One logged time: sampled S and B planes, sized from a header
+struct snapshotFrame {
+    double t = 0.0;
+    std::vector<double> S;
+    std::vector<double> B;
+
+    snapshotFrame() = default;
+    explicit snapshotFrame(const snapshotHeader& hdr) : S(hdr.planeValues()), B(hdr.planeValues()) {}
+};
+
+//! Copy every stride-th row and column of a gridRows x gridCols plane into hdr.rows x hdr.cols
+inline void sampleSnapshotPlane(const double* grid, const snapshotHeader& hdr, double* out) {
+    for (uint32_t i = 0; i < hdr.rows; ++i) {
+        const double* src = grid + static_cast<size_t>(i) * hdr.stride * hdr.gridCols;
+        for (uint32_t j = 0; j < hdr.cols; ++j) {
+            out[static_cast<size_t>(i) * hdr.cols + j] = src[static_cast<size_t>(j) * hdr.stride];
+        }
+    }
+}
+
+constexpr char snapshotMagic[8] = {'V', 'E', 'G', 'S', 'N', 'A', 'P', '1'};
+constexpr uint32_t snapshotVersion = 1;
+
+//! Parse a .vsnap header, leaving `in` at the first frame
+inline snapshotHeader readSnapshotHeader(std::istream& in, const std::string& filename) {
+    auto get = [&in] {
+        uint32_t v = 0;
+        in.read(reinterpret_cast<char*>(&v), sizeof(v));
+        return v;
+    };
+    char m[sizeof(snapshotMagic)];
+    in.read(m, sizeof(m));
+    if (!in || std::memcmp(m, snapshotMagic, sizeof(snapshotMagic)) != 0) throw std::runtime_error("snapshot: bad magic in " + filename);
+    if (get() != snapshotVersion) throw std::runtime_error("snapshot: unsupported version in " + filename);
+    snapshotHeader hdr;
+    hdr.rows = get();
+    hdr.cols = get();
+    hdr.stride = get();
+    hdr.gridRows = get();
+    hdr.gridCols = get();
+    hdr.dtype = get();
+    hdr.compression = static_cast<snapshotCodec>(get());
+    hdr.fields.resize(get());
+    for (auto& f : hdr.fields) {
+        f.resize(get());
+        in.read(f.data(), static_cast<std::streamsize>(f.size()));
+    }
+    if (!in || (hdr.dtype != 4 && hdr.dtype != 8)) throw std::runtime_error("snapshot: corrupt header");
+    return hdr;
+}
+
+//! True when frames written under `a` and `b` have the same layout
+inline bool sameSnapshotLayout(const snapshotHeader& a, const snapshotHeader& b) {
+    return a.rows == b.rows && a.cols == b.cols && a.stride == b.stride && a.gridRows == b.gridRows &&
+           a.gridCols == b.gridCols && a.dtype == b.dtype && a.compression == b.compression && a.fields == b.fields;
+}
+
+/**
+ * @brief Writes frames through large block writes.
+ * The raw and compressed frame buffers are allocated once in the constructor
+ * and reused, so steady-state logging does no per-frame allocation.
+ */
+class snapshotWriter {
+public:
+    //! With append set, frames are added to an existing file, which must have been
+    //! written with the same header (shape, stride, dtype, codec and fields)
+    snapshotWriter(const std::string& filename, const snapshotHeader& hdr, bool append = false) : hdr(hdr) {
+        if (hdr.dtype != 4 && hdr.dtype != 8) throw std::invalid_argument("snapshot: dtype must be 4 or 8 bytes");
+        if (append) {
+            std::ifstream existing(filename, std::ios::binary | std::ios::ate);
+            const std::streamoff size = existing.is_open() ? static_cast<std::streamoff>(existing.tellg()) : 0;
+            append = size > 0;
+            if (append) {
+                existing.seekg(0);
+                if (!sameSnapshotLayout(readSnapshotHeader(existing, filename), hdr)) {
+                    throw std::runtime_error("snapshot: " + filename + " was written with a different header "
+                                             "(shape, stride, dtype or codec); cannot append to it");
+                }
+                bytesWritten = static_cast<uint64_t>(size);
+            }
+        }
+        out.open(filename, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+        if (!out.is_open()) throw std::runtime_error("snapshot: cannot open " + filename);
+        raw.resize(hdr.frameBytes());
+        shuffled.resize(hdr.frameBytes());
+        packed.reserve(hdr.frameBytes() + hdr.frameBytes() / 255 + 16);
+        if (append) return;
+
+        out.write(snapshotMagic, sizeof(snapshotMagic));
+        put(snapshotVersion);
+        put(hdr.rows);
+        put(hdr.cols);
+        put(hdr.stride);
+        put(hdr.gridRows);
+        put(hdr.gridCols);
+        put(hdr.dtype);
+        put(static_cast<uint32_t>(hdr.compression));
+        put(static_cast<uint32_t>(hdr.fields.size()));
+        for (const auto& f : hdr.fields) {
+            put(static_cast<uint32_t>(f.size()));
+            out.write(f.data(), static_cast<std::streamsize>(f.size()));
+        }
+        bytesWritten = static_cast<uint64_t>(out.tellp());
+    }
+
+    //! Append one frame; planes[k] holds rows * cols doubles for hdr.fields[k]
+    void writeFrame(double t, const std::vector<const double*>& planes) {
+        const size_t n = hdr.planeValues();
+        for (size_t f = 0; f < planes.size(); ++f) {
+            uint8_t* dst = raw.data() + f * n * hdr.dtype;
+            if (hdr.dtype == 8) {
+                std::memcpy(dst, planes[f], n * sizeof(double));
+            } else {
+                for (size_t k = 0; k < n; ++k) {
+                    const float v = static_cast<float>(planes[f][k]);
+                    std::memcpy(dst + k * sizeof(float), &v, sizeof(float));
+                }
+            }
+        }
+        const uint8_t* payload = raw.data();
+        size_t stored = raw.size();
+        if (hdr.compression == snapshotCodec::lz) {
+            snapshotShuffle(raw.data(), shuffled.data(), raw.size() / hdr.dtype, hdr.dtype);
+            lzCompress(shuffled.data(), shuffled.size(), packed, matchTable);
+            payload = packed.data();
+            stored = packed.size();
+        }
+        put(t);
+        put(static_cast<uint64_t>(stored));
+        put(static_cast<uint64_t>(raw.size()));
+        out.write(reinterpret_cast<const char*>(payload), static_cast<std::streamsize>(stored));
+        bytesWritten += stored + sizeof(double) + 2 * sizeof(uint64_t);
+    }
+
+    void flush() {
+        out.flush();
+    }
+
+    void close() {
+        if (out.is_open()) out.close();
+    }
+
+    //! Size of the file so far, header included
+    [[nodiscard]] uint64_t bytes() const { return bytesWritten; }
+
+private:
+    snapshotHeader hdr;
+    std::ofstream out;
+    std::vector<uint8_t> raw;
+    std::vector<uint8_t> shuffled;
+    std::vector<uint8_t> packed;
+    std::vector<uint32_t> matchTable;
+    uint64_t bytesWritten = 0;
+
+    template <class T>
+    void put(T v) { out.write(reinterpret_cast<const char*>(&v), sizeof(T)); }
+};
+
+//! Sequential frame reader; planes are returned as doubles whatever the stored dtype
+class snapshotReader {
+public:
+    explicit snapshotReader(const std::string& filename) {
+        in.open(filename, std::ios::binary);
+        if (!in.is_open()) throw std::runtime_error("snapshot: cannot open " + filename);
+        hdr = readSnapshotHeader(in, filename);
+    }
+
+    [[nodiscard]] const snapshotHeader& info() const { return hdr; }
+
+    //! Read the next frame into planes[field][cell]; false at end of file
+    bool next(double& t, std::vector<std::vector<double>>& planes) {
+        if (!in.read(reinterpret_cast<char*>(&t), sizeof(t))) return false;
+        const auto stored = get<uint64_t>();
+        const auto rawSize = get<uint64_t>();
+        if (rawSize != hdr.frameBytes()) throw std::runtime_error("snapshot: frame size mismatch");
+        payload.resize(stored);
+        in.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(stored));
+        if (!in) throw std::runtime_error("snapshot: truncated frame");
+
+        raw.resize(rawSize);
+        if (hdr.compression == snapshotCodec::lz) {
+            shuffled.resize(rawSize);
+            lzDecompress(payload.data(), payload.size(), shuffled.data(), rawSize);
+            snapshotUnshuffle(shuffled.data(), raw.data(), rawSize / hdr.dtype, hdr.dtype);
+        } else {
+            raw.swap(payload);
+        }
+
+        const size_t n = hdr.planeValues();
+        planes.resize(hdr.fields.size());
+        for (size_t f = 0; f < planes.size(); ++f) {
+            planes[f].resize(n);
+            const uint8_t* src = raw.data() + f * n * hdr.dtype;
+            for (size_t k = 0; k < n; ++k) {
+                if (hdr.dtype == 8) {
+                    std::memcpy(&planes[f][k], src + k * sizeof(double), sizeof(double));
+                } else {
+                    float v;
+                    std::memcpy(&v, src + k * sizeof(float), sizeof(float));
+                    planes[f][k] = v;
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    snapshotHeader hdr;
+    std::ifstream in;
+    std::vector<uint8_t> payload;
+    std::vector<uint8_t> shuffled;
+    std::vector<uint8_t> raw;
+
+    template <class T>
+    T get() {
+        T v{};
+        in.read(reinterpret_cast<char*>(&v), sizeof(T));
+        return v;
+    }
+};
+
+#endif // CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_SNAPSHOT_HPP_
@@ -2,16 +2,43 @@
 #ifndef CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_STATE_HPP_
 #define CADMIUM_EXAMPLE_CELLDEVS_VEGETATION_STATE_HPP_
 
+#include <cstdint>
 #include <iostream>
 #include <nlohmann/json.hpp>
 
+//! splitmix64 finalizer
+inline uint64_t vegetationMix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+//! Counter-based generator: value `counter` of stream `seed`, computed without any state
+inline uint64_t vegetationHash(uint64_t seed, uint64_t counter) {
+    return vegetationMix(vegetationMix(seed) + (counter + 1) * 0x9E3779B97F4A7C15ull);
+}
+
+//! The random default state: cell `index` of stream `seed` starts with biomass on ~10% of cells
+inline bool vegetationSeeded(uint64_t seed, uint64_t index) {
+    return vegetationHash(seed, index) % 10 < 1;
+}
+
+//! scenario.seed for Cadmium cells without an explicit state; set once before the model is built
+inline uint64_t vegetationDefaultSeed = 0;
+
 //! Turing vegetation state: S = soil moisture, B = biomass
 struct vegetationState {
     double S;
     double B;
-    vegetationState(): S(1.0), B( (std::rand()%10<1) ? 2.0 : 0.0 ) {} 
+    vegetationState(): S(1.0), B(0.0) {}
+    vegetationState(double s, double b): S(s), B(b) {}
 };
 
+//! The random default state of cell `index` (row-major) in stream `seed`
+inline vegetationState vegetationDefaultState(uint64_t seed, uint64_t index) {
+    return {1.0, vegetationSeeded(seed, index) ? 2.0 : 0.0};
+}
+
 //! Stream‐output for logging
 inline std::ostream& operator<<(std::ostream& os, const vegetationState& x) {
     os << "<"<<x.B << ", " << x.S <<">";
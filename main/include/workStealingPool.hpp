@@ -0,0 +1,138 @@
+// include/workStealingPool.hpp
+#ifndef CADMIUM_EXAMPLE_CELLDEVS_WORK_STEALING_POOL_HPP_
+#define CADMIUM_EXAMPLE_CELLDEVS_WORK_STEALING_POOL_HPP_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed-size thread pool that runs batches of indexed tasks with work stealing.
+ * Each batch is split into contiguous blocks, one per worker deque, so neighbouring
+ * tiles stay on the same core. A worker pops from the back of its own deque and,
+ * once empty, steals from the front of the others. The calling thread is worker 0.
+ */
+class workStealingPool {
+public:
+    explicit workStealingPool(unsigned threads) {
+        if (threads == 0) threads = 1;
+        for (unsigned w = 0; w < threads; ++w) {
+            queues.push_back(std::make_unique<taskQueue>());
+        }
+        for (unsigned w = 1; w < threads; ++w) {
+            workers.emplace_back([this, w] { workerLoop(w); });
+        }
+    }
+
+    ~workStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(batchMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& t : workers) t.join();
+    }
+
+    workStealingPool(const workStealingPool&) = delete;
+    workStealingPool& operator=(const workStealingPool&) = delete;
+
+    [[nodiscard]] unsigned size() const { return static_cast<unsigned>(queues.size()); }
+
+    //! Run task(0) ... task(nTasks - 1) across the pool and return once all have finished
+    void run(size_t nTasks, const std::function<void(size_t)>& task) {
+        const size_t nQueues = queues.size();
+        for (size_t w = 0; w < nQueues; ++w) {
+            std::lock_guard<std::mutex> lock(queues[w]->mutex);
+            for (size_t k = w * nTasks / nQueues; k < (w + 1) * nTasks / nQueues; ++k) {
+                queues[w]->tasks.push_back(k);
+            }
+        }
+        if (workers.empty()) {
+            drain(0, task);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(batchMutex);
+            job = &task;
+            pending = static_cast<unsigned>(workers.size());
+            ++generation;
+        }
+        wake.notify_all();
+        drain(0, task);
+
+        std::unique_lock<std::mutex> lock(batchMutex);
+        done.wait(lock, [this] { return pending == 0; });
+        job = nullptr;
+    }
+
+private:
+    struct taskQueue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    std::vector<std::unique_ptr<taskQueue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex batchMutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(size_t)>* job = nullptr;
+    uint64_t generation = 0;
+    unsigned pending = 0;       //!< workers that have not finished the current batch
+    bool stopping = false;
+
+    bool popOwn(size_t self, size_t& task) {
+        std::lock_guard<std::mutex> lock(queues[self]->mutex);
+        if (queues[self]->tasks.empty()) return false;
+        task = queues[self]->tasks.back();
+        queues[self]->tasks.pop_back();
+        return true;
+    }
+
+    bool steal(size_t self, size_t& task) {
+        const size_t nQueues = queues.size();
+        for (size_t k = 1; k < nQueues; ++k) {
+            auto& victim = *queues[(self + k) % nQueues];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.tasks.empty()) continue;
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void drain(size_t self, const std::function<void(size_t)>& task) {
+        size_t k;
+        while (popOwn(self, k) || steal(self, k)) {
+            task(k);
+        }
+    }
+
+    void workerLoop(unsigned self) {
+        uint64_t seen = 0;
+        for (;;) {
+            const std::function<void(size_t)>* current;
+            {
+                std::unique_lock<std::mutex> lock(batchMutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                current = job;
+            }
+            drain(self, *current);
+            {
+                std::lock_guard<std::mutex> lock(batchMutex);
+                --pending;
+            }
+            done.notify_one();
+        }
+    }
+};
+
+#endif // CADMIUM_EXAMPLE_CELLDEVS_WORK_STEALING_POOL_HPP_
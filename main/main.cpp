@@ -1,47 +1,147 @@
 #include <cadmium/modeling/celldevs/grid/coupled.hpp>
 #include <cadmium/simulation/root_coordinator.hpp>
 #include <cadmium/simulation/logger/logger.hpp>
+#include <cctype>
+#include <charconv>
 #include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
+#include <memory>
+#include <sstream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "include/vegetationCell.hpp"
 #include "include/vegetationState.hpp"
+#include "include/vegetationDense.hpp"
+#include "include/vegetationSnapshot.hpp"
+#include "include/asyncFrameQueue.hpp"
+#include "include/vegetationCheckpoint.hpp"
+#include "include/vegetationProfile.hpp"
+#include "include/vegetationRun.hpp"
 
 using namespace cadmium::celldevs;
 using namespace cadmium;
 
+// Command-line options shared by the Cadmium and dense paths
+struct runOptions {
+    std::string configFilePath;
+    double simTime = 100.0;
+    std::string engine = "cadmium";
+    std::string kernel = "auto";
+    unsigned threads = 1;
+    int temporalBlock = 0;      // --temporal-block=k overrides scenario.temporal_block
+    int syntheticRows = 0;      // --synthetic=RxC replaces the scenario file (dense only)
+    int syntheticCols = 0;
+    std::string logFormat = "csv";                  // --log=csv|binary
+    uint32_t logDtype = 0;                          // --log-dtype=f32|f64 (binary only; 0 = engine default)
+    snapshotCodec logCodec = snapshotCodec::raw;    // --log-codec=raw|lz (binary only)
+    double logInterval = 1.0;                       // --log-interval=T: frame every T time units
+    uint32_t logStride = 1;                         // --log-stride=N: every N-th row and column
+    size_t logBuffers = 4;                          // --log-buffers=K: frames queued for the writer
+    backPressure logPolicy = backPressure::block;   // --log-policy=block|drop|decimate
+    double checkpointEvery = 0.0;                   // --checkpoint-every=T (dense only, 0 = off)
+    std::string checkpointPath = "vegetation.ckpt"; // --checkpoint=PATH
+    std::string resumePath;                         // --resume PATH
+    bool ensemble = false;                          // --ensemble: run the scenario "ensemble" list (dense only)
+    unsigned ensembleSeeds = 0;                     // --ensemble-seeds=N: N random initial states instead
+};
+
+static snapshotHeader snapshotHeaderFor(const runOptions& opts, int rows, int cols) {
+    snapshotHeader hdr;
+    hdr.gridRows = static_cast<uint32_t>(rows);
+    hdr.gridCols = static_cast<uint32_t>(cols);
+    hdr.stride = std::max<uint32_t>(opts.logStride, 1);
+    hdr.rows = sampledExtent(hdr.gridRows, hdr.stride);
+    hdr.cols = sampledExtent(hdr.gridCols, hdr.stride);
+    hdr.dtype = opts.logDtype != 0 ? opts.logDtype : 8;
+    hdr.compression = opts.logCodec;
+    return hdr;
+}
+
+// First n numbers in a string such as "(12,34)" or "<0.5, 1.2>"
+template <class T>
+static bool parseNumbers(const std::string& text, T* out, int n) {
+    const char* p = text.c_str();
+    for (int k = 0; k < n; ++k) {
+        while (*p && !(std::isdigit(static_cast<unsigned char>(*p)) || *p == '-' || *p == '.')) ++p;
+        if (!*p) return false;
+        char* end;
+        if constexpr (std::is_integral_v<T>) out[k] = std::strtol(p, &end, 10);
+        else out[k] = std::strtod(p, &end);
+        if (end == p) return false;
+        p = end;
+    }
+    return true;
+}
+
 // -----------------------
 // Custom CSV Logger
 // -----------------------
+// The records of one logged time are collected raw (time, id and the three strings back
+// to back) into an in-memory frame; complete frames are handed to a writer thread, which
+// formats the CSV lines and writes them, so the simulation loop never formats or waits on the file.
+struct csvRecord {
+    double t;
+    long modelId;
+    uint32_t nameLength;
+    uint32_t portLength;
+    uint32_t dataLength;
+};
+
+struct csvFrame {
+    std::vector<csvRecord> records;
+    std::string text;       // model name, port name and data of every record, concatenated
+
+    void clear() {
+        records.clear();
+        text.clear();
+    }
+};
+
 class CustomCSVLogger : public Logger {
 public:
     std::ofstream out;
     std::string delimiter;
     double logInterval;
+    uint32_t stride;
+    std::vector<int> origin;                    // scenario.origin: model name of grid cell (0, 0)
+    csvFrame pending;                           // records of the frame being collected
+    double frameTime = -1.0;
+    bool frameDue = false;
+    std::string lines;                          // writer thread only: formatted frame
+    asyncFrameQueue<csvFrame> frames;
 
     CustomCSVLogger(const std::string& filename,
                     const std::string& delim,
-                    double interval)
-        : delimiter(delim), logInterval(interval) {
+                    double interval,
+                    const std::vector<int>& origin = {0, 0},
+                    const runOptions& opts = {})
+        : delimiter(delim), logInterval(interval), stride(std::max<uint32_t>(opts.logStride, 1))
+        , origin(origin)
+        , frames(opts.logBuffers, opts.logPolicy, [this](csvFrame& frame) { write(frame); }) {
         out.open(filename);
         if (!out.is_open()) {
             std::cerr << "Error opening log file: " << filename << std::endl;
         }
-        // CSV header
-        out << "time" << delimiter
-            << "model_id" << delimiter
-            << "model_name" << delimiter
-            << "port_name" << delimiter
-            << "data" << "\n";
+        writeCSVHeader(out, delimiter);
     }
 
     void start() override {}
     void stop() override {
+        flush();
+        frames.close();
         if (out.is_open()) out.close();
+        frames.report(std::cout, "CSV logger");
     }
 
     void logOutput(double t,
@@ -49,12 +149,11 @@ public:
                    const std::string& modelName,
                    const std::string& portName,
                    const std::string& data) override {
-        if (std::fabs(std::fmod(t, logInterval)) < 1e-9) {
-            out << t << delimiter
-                << modelId << delimiter
-                << modelName << delimiter
-                << portName << delimiter
-                << data << "\n";
+        profileScope profile(profilePhase::logFormat);
+        if (due(t, modelName)) {
+            const auto started = std::chrono::steady_clock::now();
+            append(t, modelId, modelName, portName, data);
+            frames.addCollectionTime(std::chrono::steady_clock::now() - started);
         }
     }
 
@@ -62,78 +161,672 @@ public:
                   long modelId,
                   const std::string& modelName,
                   const std::string& state) override {
-        if (std::fabs(std::fmod(t, logInterval)) < 1e-9) {
-            out << t << delimiter
-                << modelId << delimiter
-                << modelName << delimiter
-                << ""         << delimiter
-                << state      << "\n";
+        profileScope profile(profilePhase::logFormat);
+        if (due(t, modelName)) {
+            const auto started = std::chrono::steady_clock::now();
+            append(t, modelId, modelName, "", state);
+            frames.addCollectionTime(std::chrono::steady_clock::now() - started);
         }
     }
 
     ~CustomCSVLogger() {
+        flush();
+        frames.close();
         if (out.is_open()) out.close();
     }
+
+private:
+    // Time cadence is checked once per distinct time, space cadence per cell
+    bool due(double t, const std::string& modelName) {
+        if (t != frameTime) {
+            flush();
+            frameTime = t;
+            frameDue = std::fabs(std::fmod(t, logInterval)) < 1e-9;
+        }
+        if (!frameDue) return false;
+        if (stride == 1) return true;
+        long id[2];
+        return parseNumbers(modelName, id, 2) && (id[0] - origin[0]) % stride == 0 &&
+               (id[1] - origin[1]) % stride == 0;
+    }
+
+    void append(double t, long modelId, const std::string& modelName,
+                const std::string& portName, const std::string& data) {
+        pending.records.push_back({t, modelId, static_cast<uint32_t>(modelName.size()),
+                                   static_cast<uint32_t>(portName.size()), static_cast<uint32_t>(data.size())});
+        pending.text.append(modelName).append(portName).append(data);
+    }
+
+    void flush() {
+        if (pending.records.empty()) return;
+        if (csvFrame* frame = frames.acquire()) {
+            std::swap(*frame, pending);   // buffers circulate, keeping their capacity
+            frames.publish();
+        }
+        pending.clear();
+    }
+
+    // Writer thread: same text as streaming into the ofstream (default %g formatting),
+    // without a stream per line
+    void write(csvFrame& frame) {
+        profileScope profile(profilePhase::logWrite);
+        lines.clear();
+        const char* text = frame.text.data();
+        char number[32];
+        for (const csvRecord& r : frame.records) {
+            auto end = std::to_chars(number, number + sizeof(number), r.t, std::chars_format::general, 6).ptr;
+            lines.append(number, end).append(delimiter);
+            end = std::to_chars(number, number + sizeof(number), r.modelId).ptr;
+            lines.append(number, end).append(delimiter);
+            lines.append(text, r.nameLength).append(delimiter);
+            text += r.nameLength;
+            lines.append(text, r.portLength).append(delimiter);
+            text += r.portLength;
+            lines.append(text, r.dataLength).append("\n");
+            text += r.dataLength;
+        }
+        out << lines;
+        frame.clear();
+    }
+};
+
+// -----------------------
+// Binary Snapshot Logger
+// -----------------------
+// Collects the state strings Cadmium passes to the logger into S/B planes and hands
+// one sampled frame per logged time to a snapshotWriter on the writer thread; the
+// cell index comes from the model name, relative to scenario.origin. The states arrive
+// as vegetationState's operator<< text (6 significant digits), so a float64 file holds
+// no more precision than a float32 one.
+class SnapshotLogger : public Logger {
+public:
+    snapshotHeader hdr;
+    snapshotWriter writer;
+    double logInterval;
+    std::vector<int> origin;                    // scenario.origin: model name of grid cell (0, 0)
+    std::vector<double> S;
+    std::vector<double> B;
+    double frameTime = -1.0;
+    bool frameDue = false;
+    asyncFrameQueue<snapshotFrame> frames;
+
+    SnapshotLogger(const std::string& filename,
+                   const snapshotHeader& header,
+                   double interval,
+                   const std::vector<int>& origin = {0, 0},
+                   const runOptions& opts = {})
+        : hdr(header), writer(filename, header), logInterval(interval), origin(origin)
+        , S(static_cast<size_t>(header.gridRows) * header.gridCols, 0.0), B(S)
+        , frames(opts.logBuffers, opts.logPolicy,
+                 [this](snapshotFrame& f) {
+                     profileScope profile(profilePhase::logWrite);
+                     writer.writeFrame(f.t, {f.S.data(), f.B.data()});
+                 },
+                 snapshotFrame(header)) {}
+
+    void start() override {}
+    void stop() override {
+        flush();
+        frames.close();
+        writer.close();
+        frames.report(std::cout, "Snapshot logger");
+    }
+
+    // Output messages carry the same state as the following logState call
+    void logOutput(double, long, const std::string&, const std::string&, const std::string&) override {}
+
+    void logState(double t,
+                  long,
+                  const std::string& modelName,
+                  const std::string& state) override {
+        profileScope profile(profilePhase::logFormat);
+        if (t != frameTime) {
+            flush();
+            frameTime = t;
+            frameDue = std::fabs(std::fmod(t, logInterval)) < 1e-9;  // once per distinct time
+        }
+        // Every state is parsed, so cells that do not change at a logged time keep their value
+        const auto started = std::chrono::steady_clock::now();
+        long id[2];
+        double value[2];
+        if (parseNumbers(modelName, id, 2) && parseNumbers(state, value, 2)) {
+            const long i = id[0] - origin[0];
+            const long j = id[1] - origin[1];
+            if (i >= 0 && i < static_cast<long>(hdr.gridRows) && j >= 0 && j < static_cast<long>(hdr.gridCols)) {
+                const size_t k = static_cast<size_t>(i) * hdr.gridCols + static_cast<size_t>(j);
+                B[k] = value[0];  // vegetationState prints "<B, S>"
+                S[k] = value[1];
+            }
+        }
+        frames.addCollectionTime(std::chrono::steady_clock::now() - started);
+    }
+
+    ~SnapshotLogger() {
+        flush();
+        frames.close();
+    }
+
+private:
+    void flush() {
+        if (frameDue) {
+            if (snapshotFrame* f = frames.acquire()) {
+                f->t = frameTime;
+                sampleSnapshotPlane(S.data(), hdr, f->S.data());
+                sampleSnapshotPlane(B.data(), hdr, f->B.data());
+                frames.publish();
+            }
+        }
+        frameDue = false;
+    }
 };
 
-// Factory: create vegetation cells
-static std::shared_ptr<GridCell<vegetationState, double>> addGridCell(
-    const std::vector<int>& cellId,
-    const std::shared_ptr<const GridCellConfig<vegetationState, double>>& cellConfig) {
-    if (cellConfig->cellModel == "vegetation") {
-        return std::make_shared<vegetationCell>(cellId, cellConfig);
+// Whole-string number such as a simulation time; false leaves value unchanged
+static bool parseNumber(const std::string& text, double& value) {
+    char* end = nullptr;
+    const double parsed = std::strtod(text.c_str(), &end);
+    if (text.empty() || *end != '\0') return false;
+    value = parsed;
+    return true;
+}
+
+// Simple console progress bar
+static void printProgress(double currentTime, double simTime) {
+    const int barWidth = 50;
+    double pct = (currentTime / simTime) * 100.0;
+    int pos = static_cast<int>(barWidth * pct / 100.0);
+    std::cout << "\rProgress: [";
+    for (int i = 0; i < barWidth; ++i) {
+        if (i < pos)      std::cout << "=";
+        else if (i == pos) std::cout << ">";
+        else               std::cout << " ";
+    }
+    std::cout << "] " << std::fixed << std::setprecision(1)
+              << pct << "%, t=" << currentTime << "/" << simTime;
+    std::cout.flush();
+}
+
+static nlohmann::json readScenarioSection(const std::string& configFilePath) {
+    std::ifstream in(configFilePath);
+    return nlohmann::json::parse(in).at("scenario");
+}
+
+static std::pair<int, int> readScenarioShape(const std::string& configFilePath) {
+    const auto shape = readScenarioSection(configFilePath).at("shape");
+    return {shape.at(0).get<int>(), shape.at(1).get<int>()};
+}
+
+static void printStartup(const std::string& phases) {
+    const auto precision = std::cout.precision();
+    std::cout << "Startup: " << phases << ", peak RSS " << std::fixed << std::setprecision(1)
+              << peakRSSMiB() << " MiB" << std::defaultfloat << std::setprecision(precision) << std::endl;
+}
+
+static denseScenario loadScenario(const runOptions& opts) {
+    if (opts.syntheticRows > 0) {
+        return syntheticDenseScenario(opts.syntheticRows, opts.syntheticCols);
+    }
+    return loadDenseScenario(opts.configFilePath);
+}
+
+// Dense engine: one fused SoA sweep per time unit, same CSV layout as the Cadmium run
+static int runDense(const runOptions& opts) {
+    // The scenario's copy of the grid is released once the engine holds it
+    std::unique_ptr<vegetationDense> built;
+    {
+        auto started = std::chrono::steady_clock::now();
+        const denseScenario scenario = loadScenario(opts);
+        const double loadSeconds = secondsSince(started);
+        started = std::chrono::steady_clock::now();
+        built = std::make_unique<vegetationDense>(scenario, opts.kernel);
+        std::ostringstream phases;
+        phases << std::fixed << std::setprecision(4) << "scenario load " << loadSeconds << " s, engine setup " << secondsSince(started) << " s";
+        printStartup(phases.str());
+    }
+    vegetationDense& engine = *built;
+    engine.setThreads(opts.threads);
+    if (opts.temporalBlock > 0) engine.setTemporalBlock(opts.temporalBlock);
+
+    // Frames go to vegetation_log.csv, or to vegetation_log.vsnap with --log=binary
+    const snapshotHeader hdr = snapshotHeaderFor(opts, engine.rows(), engine.cols());
+    const std::string logPath = (opts.logFormat == "binary") ? "vegetation_log.vsnap" : "vegetation_log.csv";
+
+    // Resume: restore the grid and step count, and cut the log back to its
+    // size at the checkpoint so the frames after it are not written twice
+    long step = 0;
+    const bool resuming = !opts.resumePath.empty();
+    if (resuming) {
+        const vegetationCheckpoint ckpt = readCheckpointFile(opts.resumePath);
+        if (ckpt.rows != static_cast<uint32_t>(engine.rows()) || ckpt.cols != static_cast<uint32_t>(engine.cols())) {
+            std::cerr << "Checkpoint " << opts.resumePath << " does not match the scenario shape" << std::endl;
+            return 1;
+        }
+        std::error_code ec;
+        const auto logSize = std::filesystem::file_size(logPath, ec);
+        if (ec || logSize < ckpt.logBytes) {
+            std::cerr << "Cannot resume: " << logPath << " is missing or shorter than when " << opts.resumePath
+                      << " was written (" << ckpt.logBytes << " bytes)" << std::endl;
+            return 1;
+        }
+        if (opts.logFormat == "binary") {
+            std::ifstream existing(logPath, std::ios::binary);
+            if (!sameSnapshotLayout(readSnapshotHeader(existing, logPath), hdr)) {
+                std::cerr << "Cannot resume: " << logPath << " was written with a different shape, stride, "
+                          << "dtype or codec" << std::endl;
+                return 1;
+            }
+        }
+        std::filesystem::resize_file(logPath, ckpt.logBytes);
+        engine.importPlanes(ckpt.S, ckpt.B);
+        step = static_cast<long>(ckpt.step);
+        std::cout << "Resumed from " << opts.resumePath << " at t=" << ckpt.time << std::endl;
+    }
+
+    // The simulation thread only copies the sampled planes into a queued frame
+    std::ofstream out;
+    std::unique_ptr<snapshotWriter> snapshots;
+    const std::string delimiter = ";";
+    if (opts.logFormat == "binary") {
+        snapshots = std::make_unique<snapshotWriter>(logPath, hdr, resuming);
     } else {
-        throw std::bad_typeid();
+        // Not std::ios::app, so tellp() is the file size the checkpoints record
+        out.open(logPath, resuming ? std::ios::in | std::ios::out : std::ios::out | std::ios::trunc);
+        out.seekp(0, std::ios::end);
+        if (!out.is_open()) {
+            std::cerr << "Error opening log file: vegetation_log.csv" << std::endl;
+        }
+        if (!resuming) writeCSVHeader(out, delimiter);
+    }
+    // Each frame is flushed as it is written, so the size a checkpoint records is on disk
+    auto logSize = [&] { return snapshots ? snapshots->bytes() : static_cast<uint64_t>(out.tellp()); };
+    checkpointLogSize logged(logSize());
+    uint64_t published = 0;
+    asyncFrameQueue<snapshotFrame> frames(opts.logBuffers, opts.logPolicy, [&](snapshotFrame& f) {
+        profileScope profile(profilePhase::logWrite);
+        if (snapshots) {
+            snapshots->writeFrame(f.t, {f.S.data(), f.B.data()});
+            snapshots->flush();
+        } else {
+            writeSnapshotCSV(out, f.t, f.S.data(), f.B.data(), hdr, delimiter);
+            out.flush();
+        }
+        logged.frameWritten(logSize());
+    }, snapshotFrame(hdr));
+    auto logFrame = [&](double t) {
+        profileScope profile(profilePhase::logFormat);
+        if (snapshotFrame* f = frames.acquire()) {
+            f->t = t;
+            engine.exportPlanes(f->S, f->B, hdr.stride);
+            frames.publish();
+            ++published;
+        }
+    };
+    if (!resuming) logFrame(0.0);
+
+    // Checkpoints: the simulation thread copies the grid into a staging slot and the
+    // writer thread waits for the log to reach the checkpoint's frames, then hashes
+    // and writes it atomically while stepping continues
+    std::chrono::duration<double> checkpointWriteTime{0.0};
+    asyncFrameQueue<vegetationCheckpoint> checkpoints(1, backPressure::block, [&](vegetationCheckpoint& c) {
+        profileScope profile(profilePhase::checkpoint);
+        logged.wait();
+        const auto started = std::chrono::steady_clock::now();
+        try {
+            writeCheckpointFile(opts.checkpointPath, c);
+        } catch (const std::exception& e) {
+            std::cerr << "\nCheckpoint failed: " << e.what() << std::endl;
+        }
+        checkpointWriteTime += std::chrono::steady_clock::now() - started;
+    }, vegetationCheckpoint(static_cast<uint32_t>(engine.rows()), static_cast<uint32_t>(engine.cols())));
+    auto checkpoint = [&](long at) {
+        profileScope profile(profilePhase::checkpoint);
+        if (vegetationCheckpoint* c = checkpoints.acquire()) {
+            logged.request(published, &c->logBytes);
+            c->step = at;
+            c->time = static_cast<double>(at);
+            engine.exportPlanes(c->S, c->B);
+            checkpoints.publish();
+        }
+    };
+
+    // Frames every --log-interval time units (rounded to whole steps); temporal blocks
+    // never straddle a frame or a checkpoint
+    const long logEvery = std::max(1L, std::lround(opts.logInterval));
+    const long checkpointEvery = (opts.checkpointEvery > 0.0) ? std::max(1L, std::lround(opts.checkpointEvery)) : 0;
+    const long steps = static_cast<long>(std::floor(opts.simTime));
+    const long firstStep = step;
+    long checkpointCount = 0;
+    std::chrono::duration<double> computeTime{0.0};
+    while (step < steps) {
+        long next = std::min(steps, (step / logEvery + 1) * logEvery);
+        if (checkpointEvery > 0) next = std::min(next, (step / checkpointEvery + 1) * checkpointEvery);
+        auto t0 = std::chrono::steady_clock::now();
+        engine.advance(next - step);
+        computeTime += std::chrono::steady_clock::now() - t0;
+        step = next;
+
+        if (step % logEvery == 0 || step == steps) {
+            logFrame(static_cast<double>(step));
+        }
+        if (checkpointEvery > 0 && step % checkpointEvery == 0) {
+            checkpoint(step);
+            ++checkpointCount;
+        }
+        if (step % std::max(1L, steps / 200) == 0 || step == steps) {
+            printProgress(static_cast<double>(step), opts.simTime);
+        }
+    }
+    std::cout << std::endl;
+    frames.close();
+    checkpoints.close();
+    if (snapshots) snapshots->close();
+
+    std::cout << "Simulation completed at t=" << steps << std::endl;
+    frames.report(std::cout, "Logger");
+    if (checkpointCount > 0) {
+        checkpoints.report(std::cout, "Checkpoints");
+        std::cout << "Checkpoint writes: " << std::fixed << std::setprecision(1)
+                  << 1e3 * checkpointWriteTime.count() / static_cast<double>(checkpointCount)
+                  << " ms each on the writer thread, "
+                  << static_cast<double>(engine.cells()) * 2 * sizeof(double) / (1024.0 * 1024.0)
+                  << " MiB per checkpoint (" << opts.checkpointPath << ")" << std::defaultfloat << std::endl;
+    }
+    const long stepped = steps - std::min(steps, firstStep);
+    std::cout << "Dense engine (" << engine.kernelName() << " kernel, " << engine.threads() << " thread(s)): "
+              << engine.rows() << "x" << engine.cols() << " cells, "
+              << stepped << " steps in " << std::setprecision(3) << computeTime.count() << " s ("
+              << std::scientific << cellUpdatesPerSecond(engine, stepped, computeTime.count())
+              << " cell-updates/s)" << std::defaultfloat << std::endl;
+    if (profilingEnabled) {
+        profileReport(std::cout, static_cast<double>(engine.cells()) * static_cast<double>(stepped));
+    }
+    return 0;
+}
+
+// Ensemble: every member of the scenario "ensemble" list (or N random seeds) advances in
+// one interleaved engine and logs to its own vegetation_log_m<k>.csv / .vsnap
+static int runEnsemble(const runOptions& opts) {
+    auto t0 = std::chrono::steady_clock::now();
+    const denseScenario scenario = loadScenario(opts);
+    const double loadSeconds = secondsSince(t0);
+    std::vector<denseMember> members = scenario.ensemble;
+    if (opts.ensembleSeeds > 0) {
+        members.clear();
+        for (unsigned k = 0; k < opts.ensembleSeeds; ++k) {
+            members.push_back({scenario.params, static_cast<long>(k) + 1});
+        }
+    }
+    if (members.empty()) {
+        std::cerr << "Scenario has no \"ensemble\" list; use --ensemble-seeds=N for a seed ensemble" << std::endl;
+        return 1;
+    }
+    const size_t M = members.size();
+
+    t0 = std::chrono::steady_clock::now();
+    vegetationDense engine(scenario, members, opts.kernel);
+    engine.setThreads(opts.threads);
+    if (opts.temporalBlock > 0) engine.setTemporalBlock(opts.temporalBlock);
+    const double setupSeconds = secondsSince(t0);
+    std::ostringstream phases;
+    phases << std::fixed << std::setprecision(4) << "scenario load " << loadSeconds << " s, engine setup " << setupSeconds << " s";
+    printStartup(phases.str());
+
+    // One queued frame carries every member; the writer thread fans it out to M files
+    const snapshotHeader hdr = snapshotHeaderFor(opts, engine.rows(), engine.cols());
+    const std::string delimiter = ";";
+    std::vector<std::ofstream> outs(M);
+    std::vector<std::unique_ptr<snapshotWriter>> snapshots(M);
+    for (size_t m = 0; m < M; ++m) {
+        const std::string base = "vegetation_log_m" + std::to_string(m);
+        if (opts.logFormat == "binary") {
+            snapshots[m] = std::make_unique<snapshotWriter>(base + ".vsnap", hdr);
+            continue;
+        }
+        outs[m].open(base + ".csv");
+        if (!outs[m].is_open()) {
+            std::cerr << "Error opening log file: " << base << ".csv" << std::endl;
+        }
+        writeCSVHeader(outs[m], delimiter);
+    }
+    asyncFrameQueue<std::vector<snapshotFrame>> frames(opts.logBuffers, opts.logPolicy,
+        [&](std::vector<snapshotFrame>& fs) {
+            profileScope profile(profilePhase::logWrite);
+            for (size_t m = 0; m < M; ++m) {
+                if (snapshots[m]) snapshots[m]->writeFrame(fs[m].t, {fs[m].S.data(), fs[m].B.data()});
+                else writeSnapshotCSV(outs[m], fs[m].t, fs[m].S.data(), fs[m].B.data(), hdr, delimiter);
+            }
+        }, std::vector<snapshotFrame>(M, snapshotFrame(hdr)));
+    auto logFrame = [&](double t) {
+        profileScope profile(profilePhase::logFormat);
+        if (std::vector<snapshotFrame>* fs = frames.acquire()) {
+            for (size_t m = 0; m < M; ++m) {
+                (*fs)[m].t = t;
+                engine.exportPlanes((*fs)[m].S, (*fs)[m].B, hdr.stride, m);
+            }
+            frames.publish();
+        }
+    };
+    logFrame(0.0);
+
+    const long logEvery = std::max(1L, std::lround(opts.logInterval));
+    const long steps = static_cast<long>(std::floor(opts.simTime));
+    std::chrono::duration<double> computeTime{0.0};
+    for (long step = 0; step < steps;) {
+        const long next = std::min(steps, (step / logEvery + 1) * logEvery);
+        t0 = std::chrono::steady_clock::now();
+        engine.advance(next - step);
+        computeTime += std::chrono::steady_clock::now() - t0;
+        step = next;
+        logFrame(static_cast<double>(step));
+        if (step % std::max(1L, steps / 200) == 0 || step == steps) {
+            printProgress(static_cast<double>(step), opts.simTime);
+        }
     }
+    std::cout << std::endl;
+    frames.close();
+    for (auto& w : snapshots) {
+        if (w) w->close();
+    }
+    std::cout << "Simulation completed at t=" << steps << std::endl;
+    frames.report(std::cout, "Logger");
+    if (profilingEnabled) {
+        profileReport(std::cout, static_cast<double>(engine.cells() * M) * static_cast<double>(steps));
+        profilingEnabled = false;   // keep the baseline run out of the counters
+    }
+
+    // Baseline: member 0 on its own, as one of M separate runs would do it (setup + stepping, no logging)
+    t0 = std::chrono::steady_clock::now();
+    vegetationDense single(scenario, {members[0]}, opts.kernel);
+    single.setThreads(opts.threads);
+    single.setTemporalBlock(engine.temporalBlockSteps());
+    single.advance(steps);
+    const double singleSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    const double ensembleSeconds = setupSeconds + computeTime.count();
+    const double separateSeconds = singleSeconds * static_cast<double>(M);
+    std::cout << "Ensemble (" << engine.kernelName() << " kernel, " << engine.threads() << " thread(s)): "
+              << M << " members on " << engine.rows() << "x" << engine.cols() << " cells, "
+              << steps << " steps in " << std::setprecision(3) << ensembleSeconds << " s ("
+              << std::scientific << cellUpdatesPerSecond(engine, steps, ensembleSeconds)
+              << " cell-updates/s)" << std::defaultfloat << std::endl;
+    std::cout << M << " separate runs (timed from member 0): " << std::setprecision(3) << separateSeconds
+              << " s (" << std::scientific << cellUpdatesPerSecond(single, steps, singleSeconds)
+              << " cell-updates/s); ensemble speedup " << std::fixed << std::setprecision(2)
+              << (ensembleSeconds > 0.0 ? separateSeconds / ensembleSeconds : 0.0) << "x"
+              << std::defaultfloat << std::endl;
+    return 0;
 }
 
 int main(int argc, char** argv) {
-    if (argc < 2) {
+    runOptions opts;
+    std::vector<std::string> positional;
+    bool badOption = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        try {
+            if (arg.rfind("--engine=", 0) == 0) {
+                opts.engine = arg.substr(9);
+            } else if (arg.rfind("--kernel=", 0) == 0) {
+                opts.kernel = arg.substr(9);
+            } else if (arg.rfind("--threads=", 0) == 0) {
+                opts.threads = static_cast<unsigned>(std::stoul(arg.substr(10)));
+            } else if (arg.rfind("--temporal-block=", 0) == 0) {
+                opts.temporalBlock = std::stoi(arg.substr(17));
+            } else if (arg.rfind("--log=", 0) == 0) {
+                opts.logFormat = arg.substr(6);
+            } else if (arg == "--log-dtype=f32") {
+                opts.logDtype = 4;
+            } else if (arg == "--log-dtype=f64") {
+                opts.logDtype = 8;
+            } else if (arg == "--log-codec=raw") {
+                opts.logCodec = snapshotCodec::raw;
+            } else if (arg == "--log-codec=lz") {
+                opts.logCodec = snapshotCodec::lz;
+            } else if (arg.rfind("--log-interval=", 0) == 0) {
+                opts.logInterval = std::stod(arg.substr(15));
+            } else if (arg.rfind("--log-stride=", 0) == 0) {
+                opts.logStride = static_cast<uint32_t>(std::stoul(arg.substr(13)));
+            } else if (arg.rfind("--log-buffers=", 0) == 0) {
+                opts.logBuffers = std::stoul(arg.substr(14));
+            } else if (arg.rfind("--log-policy=", 0) == 0) {
+                opts.logPolicy = parseBackPressure(arg.substr(13));
+            } else if (arg.rfind("--checkpoint-every=", 0) == 0) {
+                opts.checkpointEvery = std::stod(arg.substr(19));
+            } else if (arg.rfind("--checkpoint=", 0) == 0) {
+                opts.checkpointPath = arg.substr(13);
+            } else if (arg == "--resume" && i + 1 < argc) {
+                opts.resumePath = argv[++i];
+            } else if (arg.rfind("--resume=", 0) == 0) {
+                opts.resumePath = arg.substr(9);
+            } else if (arg == "--profile") {
+                profilingEnabled = true;
+            } else if (arg == "--ensemble") {
+                opts.ensemble = true;
+            } else if (arg.rfind("--ensemble-seeds=", 0) == 0) {
+                opts.ensemble = true;
+                opts.ensembleSeeds = static_cast<unsigned>(std::stoul(arg.substr(17)));
+            } else if (arg.rfind("--synthetic=", 0) == 0) {
+                std::tie(opts.syntheticRows, opts.syntheticCols) = parseSize(arg.substr(12));
+            } else if (arg.rfind("--", 0) == 0) {
+                std::cerr << "Unknown option " << arg << std::endl;
+                badOption = true;
+            } else {
+                positional.push_back(arg);
+            }
+        } catch (const std::exception&) {
+            // std::sto* and parseBackPressure reject malformed values
+            std::cerr << "Invalid value in " << arg << std::endl;
+            badOption = true;
+        }
+    }
+
+    // Positional arguments: the scenario file (unless --synthetic) and MAX_SIM_TIME
+    const bool synthetic = opts.syntheticRows > 0;
+    size_t next = 0;
+    if (!synthetic && next < positional.size()) opts.configFilePath = positional[next++];
+    if (next < positional.size() && !parseNumber(positional[next++], opts.simTime)) badOption = true;
+    if (next < positional.size()) badOption = true;
+
+    if (badOption || (opts.configFilePath.empty() && !synthetic) ||
+        (opts.engine != "cadmium" && opts.engine != "dense") || (synthetic && opts.engine != "dense") ||
+        (opts.logFormat != "csv" && opts.logFormat != "binary") ||
+        ((opts.checkpointEvery > 0.0 || !opts.resumePath.empty()) && (opts.engine != "dense" || opts.ensemble)) ||
+        (opts.ensemble && opts.engine != "dense")) {
         std::cout << "Usage: " << argv[0]
-                  << " SCENARIO_CONFIG.json [MAX_SIM_TIME]" << std::endl;
+                  << " SCENARIO_CONFIG.json [MAX_SIM_TIME] [--engine=cadmium|dense]"
+                  << " [--kernel=auto|avx512|avx2|scalar] [--threads=N] [--temporal-block=K]"
+                  << " [--synthetic=RxC]\n"
+                  << "       [--log=csv|binary] [--log-dtype=f32|f64] [--log-codec=raw|lz]\n"
+                  << "       [--log-interval=T] [--log-stride=N] [--log-buffers=K]"
+                  << " [--log-policy=block|drop|decimate]\n"
+                  << "       [--checkpoint-every=T] [--checkpoint=PATH] [--resume PATH]  (dense engine)\n"
+                  << "       [--ensemble | --ensemble-seeds=N]  (dense engine, one log per member)\n"
+                  << "       [--profile]  (per-phase time per cell-update)\n"
+                  << "Benchmarks (scaling, temporal blocking, startup) are in gray-scott-bench --mode=..."
+                  << std::endl;
         return -1;
     }
-    std::string configFilePath = argv[1];
-    double simTime = (argc > 2) ? std::stod(argv[2]) : 100.0;
+
+    std::string configFilePath = opts.configFilePath;
+    double simTime = opts.simTime;
+
+    if (opts.engine == "dense") {
+        // Unreadable scenarios, checkpoints and logs end the run with a message, not an abort
+        try {
+            return opts.ensemble ? runEnsemble(opts) : runDense(opts);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    // Cells without a configured state draw from stream scenario.seed; compact initial layers are dense-only
+    const nlohmann::json scenarioSection = readScenarioSection(configFilePath);
+    vegetationDefaultSeed = scenarioSection.value("seed", uint64_t{0});
+    if (scenarioSection.contains("initial")) {
+        std::cerr << "Warning: scenario.initial is only read by --engine=dense; using cell_map entries" << std::endl;
+    }
 
     // Build the grid-coupled model
-    auto model = std::make_shared<
-        GridCellDEVSCoupled<vegetationState, double>
-    >("vegetation", addGridCell, configFilePath);
-    model->buildModel();
+    auto started = std::chrono::steady_clock::now();
+    std::shared_ptr<GridCellDEVSCoupled<vegetationState, double>> model;
+    {
+        profileScope profile(profilePhase::modelBuild);
+        model = std::make_shared<
+            GridCellDEVSCoupled<vegetationState, double>
+        >("vegetation", addGridCell, configFilePath);
+        model->buildModel();
+    }
+    std::ostringstream phases;
+    phases << std::fixed << std::setprecision(4) << "model build " << secondsSince(started) << " s";
+    printStartup(phases.str());
 
-    // Set up the coordinator and logger (logs every 1.0 time unit)
+    // Set up the coordinator and logger (logs every --log-interval time units)
     RootCoordinator rootCoordinator(model);
-    rootCoordinator.setLogger<CustomCSVLogger>("vegetation_log.csv", ";", 1.0);
+    const auto origin = scenarioSection.value("origin", std::vector<int>{0, 0});
+    if (opts.logFormat == "binary") {
+        // The logger only sees 6-digit state text, so float32 loses nothing by default
+        runOptions logOpts = opts;
+        if (logOpts.logDtype == 0) {
+            logOpts.logDtype = 4;
+        } else if (logOpts.logDtype == 8) {
+            std::cerr << "Warning: the Cadmium engine logs states as 6-digit text; the float64 snapshot "
+                      << "holds those rounded values (use --engine=dense for full precision)" << std::endl;
+        }
+        const auto [rows, cols] = readScenarioShape(configFilePath);
+        rootCoordinator.setLogger<SnapshotLogger>("vegetation_log.vsnap", snapshotHeaderFor(logOpts, rows, cols),
+                                                  opts.logInterval, origin, logOpts);
+    } else {
+        rootCoordinator.setLogger<CustomCSVLogger>("vegetation_log.csv", ";", opts.logInterval, origin, opts);
+    }
 
     rootCoordinator.start();
 
     // Run simulation with a simple console progress bar
     const double interval = 1.0;
     double currentTime = 0.0;
-    const int barWidth = 50;
 
+    std::chrono::steady_clock::duration simulateTime{};
     while (currentTime < simTime) {
         currentTime += interval;
         if (currentTime > simTime) currentTime = simTime;
 
+        const auto t0 = std::chrono::steady_clock::now();
         rootCoordinator.simulate(currentTime);
-
-        double pct = (currentTime / simTime) * 100.0;
-        int pos = static_cast<int>(barWidth * pct / 100.0);
-        std::cout << "\rProgress: [";
-        for (int i = 0; i < barWidth; ++i) {
-            if (i < pos)      std::cout << "=";
-            else if (i == pos) std::cout << ">";
-            else               std::cout << " ";
-        }
-        std::cout << "] " << std::fixed << std::setprecision(1)
-                  << pct << "%, t=" << currentTime << "/" << simTime;
-        std::cout.flush();
+        simulateTime += std::chrono::steady_clock::now() - t0;
+        printProgress(currentTime, simTime);
     }
     std::cout << std::endl;
 
     rootCoordinator.stop();
     std::cout << "Simulation completed at t=" << currentTime << std::endl;
+    if (profilingEnabled) {
+        // Routing is whatever simulate() spent outside the cells and the logger
+        const auto total = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(simulateTime).count());
+        const uint64_t inside = profileNanoseconds(profilePhase::localComputation) +
+                                profileNanoseconds(profilePhase::logFormat);
+        profileAdd(profilePhase::routing, total > inside ? total - inside : 0);
+        const auto [rows, cols] = readScenarioShape(configFilePath);
+        profileReport(std::cout, static_cast<double>(rows) * cols * std::floor(simTime));
+    }
     return 0;
 }
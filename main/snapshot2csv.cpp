@@ -0,0 +1,51 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "include/vegetationSnapshot.hpp"
+
+// Convert a .vsnap snapshot file back into the CustomCSVLogger layout for the DEVS Viewer
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0]
+                  << " vegetation_log.vsnap [vegetation_log.csv]" << std::endl;
+        return -1;
+    }
+    const std::string outPath = (argc > 2) ? argv[2] : "vegetation_log.csv";
+    try {
+        snapshotReader in(argv[1]);
+        const auto& hdr = in.info();
+        const auto field = [&](const std::string& name) {
+            const auto it = std::find(hdr.fields.begin(), hdr.fields.end(), name);
+            if (it == hdr.fields.end()) throw std::runtime_error("snapshot has no field " + name);
+            return static_cast<size_t>(it - hdr.fields.begin());
+        };
+        const size_t fieldS = field("S");
+        const size_t fieldB = field("B");
+
+        std::ofstream out(outPath);
+        if (!out.is_open()) {
+            std::cerr << "Error opening log file: " << outPath << std::endl;
+            return 1;
+        }
+        const std::string delimiter = ";";
+        writeCSVHeader(out, delimiter);
+
+        double t;
+        std::vector<std::vector<double>> planes;
+        size_t frames = 0;
+        while (in.next(t, planes)) {
+            writeSnapshotCSV(out, t, planes[fieldS].data(), planes[fieldB].data(), hdr, delimiter);
+            ++frames;
+        }
+        std::cout << "Converted " << frames << " frame(s) of " << hdr.rows << "x" << hdr.cols
+                  << " cells (every " << hdr.stride << " of " << hdr.gridRows << "x" << hdr.gridCols
+                  << ") to " << outPath << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "snapshot2csv: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+// Cell-for-cell check of the dense engine against vegetationCell::localComputation.
+// Every scenario runs twice, as configured and with the opposite "wrapped" flag, so
+// both border treatments are covered. The reference steps each cell through
+// vegetationCell::update with a neighborhood map built the way Cadmium builds it.
+// Cadmium sums that map in unordered_map order while the dense kernels sum neighbors
+// in offset order, so the two agree to rounding, not bit for bit.
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "include/vegetationCell.hpp"
+#include "include/vegetationDense.hpp"
+
+static int compareScenario(const std::string& name, const denseScenario& scenario, long steps) {
+    const int rows = scenario.rows;
+    const int cols = scenario.cols;
+    vegetationDense engine(scenario);
+
+    // One map per cell pointing at the shared reference states, as Cadmium's neighbor ports do
+    std::vector<std::shared_ptr<vegetationState>> states;
+    for (const auto& st : scenario.initial) states.push_back(std::make_shared<vegetationState>(st));
+    std::vector<vegetationCell::neighborhoodMap> neighborhoods(states.size());
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            auto& neighborhood = neighborhoods[static_cast<size_t>(i) * cols + j];
+            for (const auto& [di, dj] : scenario.offsets) {
+                int ni = i + di;
+                int nj = j + dj;
+                if (ni < 0 || ni >= rows || nj < 0 || nj >= cols) {
+                    if (!scenario.wrapped) continue;
+                    ni = (ni + rows) % rows;
+                    nj = (nj + cols) % cols;
+                }
+                auto& data = neighborhood[{ni, nj}];
+                data.state = states[static_cast<size_t>(ni) * cols + nj];
+                data.vicinity = 1.0;
+            }
+        }
+    }
+
+    std::vector<vegetationState> next(states.size(), vegetationState(0.0, 0.0));
+    double worst = 0.0;
+    for (long step = 1; step <= steps; ++step) {
+        for (size_t c = 0; c < states.size(); ++c) {
+            next[c] = vegetationCell::update(*states[c], neighborhoods[c], scenario.params);
+        }
+        for (size_t c = 0; c < states.size(); ++c) *states[c] = next[c];
+        engine.step();
+
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) {
+                const vegetationState& ref = *states[static_cast<size_t>(i) * cols + j];
+                const double dS = std::fabs(engine.soil(i, j) - ref.S) / std::max(1.0, std::fabs(ref.S));
+                const double dB = std::fabs(engine.biomass(i, j) - ref.B) / std::max(1.0, std::fabs(ref.B));
+                worst = std::max({worst, dS, dB});
+                if (!(dS <= 1e-12 && dB <= 1e-12)) {
+                    std::cerr << name << ": cell (" << i << "," << j << ") differs at step " << step
+                              << ": dense <" << engine.biomass(i, j) << ", " << engine.soil(i, j)
+                              << "> vs localComputation " << ref << "\n";
+                    return 1;
+                }
+            }
+        }
+    }
+    std::cout << name << ": " << rows << "x" << cols << ", " << steps
+              << " steps, max relative difference " << worst << "\n";
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> configs;
+    long steps = 20;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--steps=", 0) == 0) steps = std::stol(arg.substr(8));
+        else configs.push_back(arg);
+    }
+    if (configs.empty()) {
+        configs = {"config/vegetation_init_101_0.1_Config.json", "config/vegetation_init_101_0.025_config.json"};
+    }
+
+    int failures = 0;
+    for (const auto& path : configs) {
+        denseScenario scenario = loadDenseScenario(path);
+        failures += compareScenario(path, scenario, steps);
+        scenario.wrapped = !scenario.wrapped;
+        failures += compareScenario(path + (scenario.wrapped ? " (wrapped)" : " (not wrapped)"), scenario, steps);
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
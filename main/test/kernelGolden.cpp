@@ -0,0 +1,88 @@
+// Golden-output test of the dense row kernels against vegetationCell::localComputation.
+// The fixture values are small multiples of 1/16, so every neighbor sum is exact in any
+// order; everything after the sums must then match localComputation bit for bit (==).
+// The targets build with -ffp-contract=off so the compiler cannot fuse the scalar and
+// vector paths differently.
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "include/vegetationCell.hpp"
+#include "include/vegetationKernel.hpp"
+
+// 3 rows of `width` elements plus a one-element border; the middle row is updated
+struct kernelFixture {
+    int width;
+    int pitch;
+    std::vector<double> S;
+    std::vector<double> B;
+    std::vector<double> count;
+    std::vector<long> offsets;
+
+    explicit kernelFixture(int w) : width(w), pitch(w + 2), S(3 * pitch), B(3 * pitch), count(w, 5.0) {
+        for (size_t k = 0; k < S.size(); ++k) {
+            S[k] = static_cast<double>(8 + (k * 5) % 17) / 16.0;
+            B[k] = (k % 3 == 0) ? 2.0 : static_cast<double>((k * 7) % 9) / 16.0;
+        }
+        offsets = {-pitch, -1, 0, 1, pitch};
+    }
+
+    [[nodiscard]] size_t center() const { return static_cast<size_t>(pitch) + 1; }
+};
+
+// localComputation's update of element j, its neighbors keyed by (row, column) as in a Cadmium grid
+static vegetationState reference(const kernelFixture& fx, int j, const vegetationParams& params) {
+    std::vector<std::shared_ptr<vegetationState>> keep;
+    vegetationCell::neighborhoodMap neighborhood;
+    for (long o : fx.offsets) {
+        const long e = static_cast<long>(fx.center()) + j + o;
+        keep.push_back(std::make_shared<vegetationState>(fx.S[e], fx.B[e]));
+        auto& data = neighborhood[{static_cast<int>(e / fx.pitch), static_cast<int>(e % fx.pitch)}];
+        data.state = keep.back();
+        data.vicinity = 1.0;
+    }
+    const size_t c = fx.center() + j;
+    return vegetationCell::update(vegetationState(fx.S[c], fx.B[c]), neighborhood, params);
+}
+
+int main() {
+    vegetationParams wet, dry;
+    wet.p = 0.3;
+    wet.gamma = 1.4;
+    dry.p = 0.1;
+    dry.beta = 2.5;
+    const std::vector<vegetationLanes> laneSets = {vegetationLanes{},
+                                                   vegetationLanes({vegetationParams{}, wet, dry})};
+
+    int failures = 0;
+    for (const auto& info : availableRowKernels()) {
+        const int before = failures;
+        for (int width : {1, 7, 37, 64}) {   // scalar-only rows, vector bodies and every tail length
+            kernelFixture fx(width);
+            for (const auto& lanes : laneSets) {
+                std::vector<double> sOut(width), bOut(width);
+                const vegetationRow row{fx.S.data() + fx.center(), fx.B.data() + fx.center(), fx.count.data(),
+                                        sOut.data(), bOut.data(), fx.offsets.data(), fx.offsets.size(), width};
+                if (!info.kernel(row, lanes)) {
+                    std::cerr << info.name << ": non-finite result on the fixture\n";
+                    ++failures;
+                    continue;
+                }
+                for (int j = 0; j < width; ++j) {
+                    const vegetationState ref = reference(fx, j, lanes.members[j % lanes.size()]);
+                    if (!(sOut[j] == ref.S && bOut[j] == ref.B)) {
+                        std::cerr << std::setprecision(17) << info.name << ": width " << width << ", " << lanes.size()
+                                  << " member(s), element " << j << ": <" << bOut[j] << ", " << sOut[j]
+                                  << "> vs localComputation " << ref << "\n";
+                        ++failures;
+                        break;
+                    }
+                }
+            }
+        }
+        std::cout << info.name << ": " << (failures == before ? "bit-identical" : "MISMATCH") << "\n";
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}